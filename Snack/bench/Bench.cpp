@@ -0,0 +1,346 @@
+// ------------------------------------------------------------------------------------
+// 模拟热点的微基准: 不依赖第三方库, 用 steady_clock 计时
+//
+// 用法:
+//   Bench [--filter TEXT] [--csv] [--min-time SECONDS]
+//
+// 每个用例先自动确定迭代次数 (单次测量至少 min-time 秒), 再重复测量 5 次,
+// 报告每次操作的最短和中位耗时 (ns); --csv 输出机器可读的结果, 方便和之前的结果对比
+//
+// 用例:
+//   step/len=N      蛇长为 N 时一个 tick 的耗时 (沿哈密顿回路走, 不会死)
+//   spawn/fill=P    棋盘被占用 P% 时生成一次食物的耗时
+//   collide/len=N   蛇长为 N 时 IsDeadly 的耗时 (随机格子, 包括越界)
+//   autopilot/WxH   自动驾驶每个 tick 做一次决定的耗时, 不含 Step 本身
+//                   (偶数边长沿回路抄近路, 101x101 没有回路, 走 BFS 和整条路径的检查)
+//   draw/full, draw/incremental
+//                   BoardRenderer 提交一帧绘制命令的 CPU 耗时 (需要 raylib, 用
+//                   SNAKE_BENCH_DRAW 编译, 打开一个隐藏窗口)
+// ------------------------------------------------------------------------------------
+#include "Autopilot.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef SNAKE_BENCH_DRAW
+#include "BoardRenderer.h"
+#endif
+
+// ------------------------------------------------------------------------------------
+// Harness
+// ------------------------------------------------------------------------------------
+struct BenchOptions
+{
+    const char *filter;
+    bool csv;
+    double minTime;
+};
+
+// 阻止编译器把结果当作没用的计算删掉
+template <class T>
+static inline void KeepAlive(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile T sink;
+    sink = value;
+#endif
+}
+
+// body(iterations) 执行 iterations 次操作, 返回实际计时的秒数 (可以排除准备工作)
+template <class Body>
+static void RunCase(const BenchOptions &options, const char *name, Body body)
+{
+    if (options.filter != nullptr && strstr(name, options.filter) == nullptr)
+        return;
+
+    // 迭代次数翻倍, 直到单次测量足够长
+    uint64_t iterations = 1;
+    double seconds = body(iterations);
+    while (seconds < options.minTime && iterations < (1ull << 40))
+    {
+        iterations *= (seconds > 0.0 && seconds * 10.0 < options.minTime) ? 10 : 2;
+        seconds = body(iterations);
+    }
+
+    const int REPEATS = 5;
+    double samples[REPEATS];
+    for (int i = 0; i < REPEATS; i++)
+    {
+        samples[i] = body(iterations) * 1e9 / (double)iterations;
+    }
+    std::sort(samples, samples + REPEATS);
+
+    if (options.csv)
+        printf("%s,%llu,%.2f,%.2f\n", name, (unsigned long long)iterations, samples[0], samples[REPEATS / 2]);
+    else
+        printf("%-24s %12llu iters %10.2f ns/op (median %.2f)\n", name, (unsigned long long)iterations, samples[0],
+               samples[REPEATS / 2]);
+}
+
+typedef std::chrono::steady_clock Clock;
+
+static double Seconds(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// ------------------------------------------------------------------------------------
+// Fixtures
+// ------------------------------------------------------------------------------------
+
+template <class Sim>
+static SnakeDirection CycleInput(const Sim &sim)
+{
+    // 沿哈密顿回路走蛇不会撞到自己, 可以一直长到占满棋盘
+    SnakeDirection dir = HamiltonianDirection(sim.GetSnake().Head().position, sim.Width(), sim.Height());
+    // 开局时蛇可能逆着回路, 先向下拐进下一行
+    return IsOpposite(dir, sim.Direction()) ? DIR_DOWN : dir;
+}
+
+// 沿回路一直走, 在蛇长第一次达到 lengths 里的每个值时保存一份状态
+static std::vector<ClassicSimulation> GrowSnapshots(const std::vector<size_t> &lengths)
+{
+    std::vector<ClassicSimulation> snapshots(lengths.size());
+    ClassicSimulation sim;
+    sim.Reset(ClassicBoard(), 1);
+
+    size_t next = 0;
+    while (next < lengths.size() && sim.Running())
+    {
+        while (next < lengths.size() && sim.GetSnake().Size() >= lengths[next])
+        {
+            CopyState(snapshots[next++], sim);
+        }
+        sim.Step(CycleInput(sim));
+    }
+    if (next < lengths.size())
+        fprintf(stderr, "snake stopped at length %zu\n", sim.GetSnake().Size());
+    return snapshots;
+}
+
+// ------------------------------------------------------------------------------------
+// Cases
+// ------------------------------------------------------------------------------------
+static void BenchStep(const BenchOptions &options, const std::vector<size_t> &lengths,
+                      const std::vector<ClassicSimulation> &snapshots)
+{
+    static ClassicSimulation sim; // 静态存储, 避免在栈上放几十 KB
+    for (size_t i = 0; i < lengths.size(); i++)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "step/len=%zu", lengths[i]);
+        RunCase(options, name, [&](uint64_t iterations) {
+            // 每 4096 个 tick 回到快照, 保持蛇长基本不变; 恢复不计时
+            double seconds = 0.0;
+            for (uint64_t done = 0; done < iterations;)
+            {
+                CopyState(sim, snapshots[i]);
+                uint64_t batch = std::min<uint64_t>(iterations - done, 4096);
+                Clock::time_point start = Clock::now();
+                for (uint64_t k = 0; k < batch; k++)
+                {
+                    KeepAlive(sim.Step(CycleInput(sim)).ateFood);
+                }
+                seconds += Seconds(start, Clock::now());
+                done += batch;
+            }
+            return seconds;
+        });
+    }
+}
+
+static void BenchSpawn(const BenchOptions &options)
+{
+    const double fills[] = {0.0, 0.5, 0.9, 0.99, 0.999};
+    static BasicFoodSpawner<ClassicBoard> spawner;
+    const ClassicBoard board;
+
+    for (double fill : fills)
+    {
+        // 按随机顺序占用 fill 比例的格子
+        std::vector<int> order(board.CellCount());
+        for (int i = 0; i < board.CellCount(); i++)
+            order[i] = i;
+        Pcg32 shuffle(7);
+        for (int i = board.CellCount() - 1; i > 0; i--)
+            std::swap(order[i], order[shuffle.Bounded((uint32_t)i + 1)]);
+
+        spawner.Reset(board);
+        int occupied = (int)(fill * board.CellCount());
+        for (int i = 0; i < occupied; i++)
+            spawner.Occupy(board.FromIndex(order[i]));
+
+        char name[64];
+        snprintf(name, sizeof(name), "spawn/fill=%g%%", fill * 100.0);
+        RunCase(options, name, [&](uint64_t iterations) {
+            Pcg32 rng(11);
+            Food food = {};
+            Clock::time_point start = Clock::now();
+            for (uint64_t k = 0; k < iterations; k++)
+            {
+                spawner.Spawn(food, rng);
+                KeepAlive(food.position.x);
+            }
+            return Seconds(start, Clock::now());
+        });
+    }
+}
+
+static void BenchCollide(const BenchOptions &options, const std::vector<size_t> &lengths,
+                         const std::vector<ClassicSimulation> &snapshots)
+{
+    // 事先生成随机格子 (包括一圈越界的格子), 计时只包括 IsDeadly
+    std::vector<Cell> probes(4096);
+    Pcg32 rng(3);
+    for (Cell &probe : probes)
+    {
+        probe.x = (int16_t)((int)rng.Bounded(GAME_AREA_WIDTH + 2) - 1);
+        probe.y = (int16_t)((int)rng.Bounded(GAME_AREA_HEIGHT + 2) - 1);
+    }
+
+    for (size_t i = 0; i < lengths.size(); i++)
+    {
+        const ClassicSimulation &sim = snapshots[i];
+        char name[64];
+        snprintf(name, sizeof(name), "collide/len=%zu", lengths[i]);
+        RunCase(options, name, [&](uint64_t iterations) {
+            int deadly = 0;
+            Clock::time_point start = Clock::now();
+            for (uint64_t k = 0; k < iterations; k++)
+            {
+                deadly += sim.IsDeadly(probes[k & (probes.size() - 1)]);
+            }
+            KeepAlive(deadly);
+            return Seconds(start, Clock::now());
+        });
+    }
+}
+
+static void BenchAutopilot(const BenchOptions &options)
+{
+    const int sizes[] = {40, 100, 101, 200};
+    for (int size : sizes)
+    {
+        const DynamicBoard board(size, size);
+        Simulation sim;
+        Autopilot autopilot;
+        autopilot.Reset(board, AUTOPILOT_BFS);
+        sim.Reset(board, 5);
+        uint32_t games = 0;
+
+        char name[64];
+        snprintf(name, sizeof(name), "autopilot/%dx%d", size, size);
+        RunCase(options, name, [&](uint64_t iterations) {
+            double seconds = 0.0;
+            for (uint64_t k = 0; k < iterations; k++)
+            {
+                if (!sim.Running())
+                    sim.Reset(board, 5, ++games);
+
+                Clock::time_point start = Clock::now();
+                SnakeDirection dir = autopilot.Decide(sim);
+                seconds += Seconds(start, Clock::now());
+                sim.Step(dir);
+            }
+            return seconds;
+        });
+    }
+}
+
+#ifdef SNAKE_BENCH_DRAW
+static void BenchDraw(const BenchOptions &options, const ClassicSimulation &snapshot)
+{
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Snake bench");
+
+    BoardRenderer renderer;
+    renderer.Load(GAME_AREA_WIDTH, GAME_AREA_HEIGHT, SQUARE_SIZE);
+    static ClassicSimulation sim;
+
+    // 只计 EndDrawing 之前提交绘制命令的时间, 不计交换缓冲区和等待 GPU
+    RunCase(options, "draw/full", [&](uint64_t iterations) {
+        CopyState(sim, snapshot);
+        double seconds = 0.0;
+        for (uint64_t k = 0; k < iterations; k++)
+        {
+            BeginDrawing();
+            Clock::time_point start = Clock::now();
+            renderer.Invalidate();
+            renderer.Draw(sim, StepResult{}, 1.0f);
+            seconds += Seconds(start, Clock::now());
+            EndDrawing();
+        }
+        return seconds;
+    });
+
+    RunCase(options, "draw/incremental", [&](uint64_t iterations) {
+        CopyState(sim, snapshot);
+        renderer.Invalidate();
+        double seconds = 0.0;
+        for (uint64_t k = 0; k < iterations; k++)
+        {
+            if (!sim.Running())
+            {
+                CopyState(sim, snapshot);
+                renderer.Invalidate();
+            }
+            StepResult step = sim.Step(CycleInput(sim));
+
+            BeginDrawing();
+            Clock::time_point start = Clock::now();
+            renderer.Apply(sim, step);
+            renderer.Draw(sim, step, 0.5f);
+            seconds += Seconds(start, Clock::now());
+            EndDrawing();
+        }
+        return seconds;
+    });
+
+    renderer.Unload();
+    CloseWindow();
+}
+#endif
+
+// ------------------------------------------------------------------------------------
+// Program main entry point
+// ------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    BenchOptions options = {nullptr, false, 0.05};
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--csv") == 0)
+            options.csv = true;
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            options.filter = argv[++i];
+        else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+            options.minTime = atof(argv[++i]);
+        else
+        {
+            fprintf(stderr, "usage: %s [--filter TEXT] [--csv] [--min-time SECONDS]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.csv)
+        printf("case,iterations,min_ns,median_ns\n");
+
+    const std::vector<size_t> lengths = {4, 16, 64, 256, 1024};
+    const std::vector<ClassicSimulation> snapshots = GrowSnapshots(lengths);
+
+    BenchStep(options, lengths, snapshots);
+    BenchSpawn(options);
+    BenchCollide(options, lengths, snapshots);
+    BenchAutopilot(options);
+#ifdef SNAKE_BENCH_DRAW
+    BenchDraw(options, snapshots.back());
+#endif
+    return 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// AssetPack: 所有资源打包成一个文件 (索引 + 数据块), 启动时整个 mmap 进来
+// 查找只是在索引里二分, 返回的指针直接指向映射的内存, 不复制也不读盘;
+// 真正的读盘发生在第一次访问页面时, 由预加载线程承担 (见 Audio.cpp)
+// 不依赖 raylib, 打包工具 (tools/PackAssets.cpp) 也用它
+//
+// 文件格式 (小端):
+//   "SPAK" | version u8 | reserved u8[3] | count u32
+//   | count 个索引项 (按名字排序): name char[ASSET_NAME_SIZE] (补 0) | offset u64 | size u64
+//   | 数据块 (每块按 ASSET_ALIGNMENT 对齐)
+// ------------------------------------------------------------------------------------
+
+constexpr size_t ASSET_NAME_SIZE = 48;  // 名字最长 47 字节
+constexpr size_t ASSET_ALIGNMENT = 16;
+constexpr const char *ASSET_PACK_FILE = "snake.pak"; // 和可执行文件放在同一个目录
+
+struct AssetBlob
+{
+    const uint8_t *data;
+    size_t size;
+};
+
+struct AssetSource
+{
+    std::string name; // 包里的名字, 例如 "eat.wav"
+    std::string path; // 打包时读取的文件
+};
+
+class AssetPack
+{
+public:
+    AssetPack(void);
+    ~AssetPack(void) { Close(); }
+
+    AssetPack(const AssetPack &) = delete;
+    AssetPack &operator=(const AssetPack &) = delete;
+
+    bool Open(const char *fileName); // 映射整个文件并校验索引; 失败时返回 false
+    void Close(void);
+    bool IsOpen(void) const { return base != nullptr; }
+
+    bool Find(const char *name, AssetBlob &blob) const;
+
+    int Count(void) const { return (int)entries.size(); }
+    const char *Name(int index) const { return entries[index].name; }
+
+private:
+    struct Entry
+    {
+        char name[ASSET_NAME_SIZE];
+        AssetBlob blob;
+    };
+
+    const uint8_t *base;
+    size_t size;
+    std::vector<Entry> entries;
+#if defined(_WIN32)
+    void *file;
+    void *mapping;
+#endif
+};
+
+// 把 sources 打包写到 fileName; 失败时打印原因并返回 false
+bool WriteAssetPack(const char *fileName, const std::vector<AssetSource> &sources);
@@ -0,0 +1,21 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------
+// 音效缓存: 在 InitAudioDevice 之后一次性加载, 关闭时统一卸载
+// 每个音效带一个小的 SoundAlias 池, 连续触发时可以重叠播放而不必重新解码
+// 音效来自可执行文件旁边的 snake.pak (AssetPack, mmap); 读盘和解码在后台线程上进行,
+// 和创建窗口 / 加载画面资源重叠, LoadGameSounds 只等它结束并上传到混音器
+// 没有打包时退回到可执行文件旁边 (再到当前目录) 的 resources/ 里的松散文件
+// ------------------------------------------------------------------------------------
+typedef enum
+{
+    SOUND_EAT = 0,
+    SOUND_GAME_OVER,
+    SOUND_COUNT
+} SoundId;
+
+void StartGameSoundPreload(void);        // Map the asset pack and decode all sounds on a background thread
+void LoadGameSounds(void);               // Wait for the preload and create all sounds (call after InitAudioDevice)
+void UnloadGameSounds(void);             // Unload all sounds (call before CloseAudioDevice)
+void PlayGameSound(SoundId sound);       // Play a cached sound, only enqueues it on the mixer
+void SetGameSoundsEnabled(bool enabled); // Mute or unmute all game sounds
@@ -0,0 +1,516 @@
+#pragma once
+
+#include "Board.h"
+#include "Cell.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// Autopilot: 自动驾驶, 用于机器人对手和长时间的稳定性测试
+// 每个 tick 之前调用 Decide 得到一个方向, 和键盘输入走同一条路径 (PlayScreen 的转向队列)
+//
+// AUTOPILOT_BFS (宽或高为偶数, 有哈密顿回路的棋盘):
+// - 沿回路走, 并在不打乱回路顺序的前提下抄近路 (cycle with shortcuts): 记每个格子在回路上的
+//   序号, 只要蛇身从尾到头按回路顺序排列, 回路上蛇头之后, 蛇尾之前的格子就一定是空的,
+//   跳到这一段里的任何格子都不会死, 跳完以后顺序仍然成立; 每一步在这一段里挑离食物最近
+//   又不越过食物的格子, 所以保证存活, 最终占满棋盘
+// - 开局 (或者中途接手) 时蛇身还没按回路排好: 先沿回路走, 走不了时选一个之后还能到达尾巴的方向,
+//   连续 Size() - 1 步都在回路上以后蛇身就是回路上连续的一段, 之后进入抄近路的模式
+//   (中途接手时缠绕的蛇身可能在排好之前就无路可走, 只有从开局起使用才保证)
+// AUTOPILOT_BFS (宽高都是奇数, 没有回路, 不保证存活):
+// - 在占用位图上 BFS 找到食物的最短路径, 让一条虚拟的蛇沿整条路径走到食物, 吃完以后还能走到
+//   自己的尾巴才采用; 路径缓存起来, 食物不变时之后的 tick 直接沿用, 每吃到一次食物才搜索一次
+// - 不安全或者吃不到时选一个之后还能走到尾巴的方向, 拖延到局面变化
+// AUTOPILOT_CYCLE:
+// - 一直沿哈密顿回路走, 不抄近路, 只要上了回路就不会死
+//
+// 回路上的序号由坐标直接算出 (HamiltonianIndex), 抄近路的每一步只看 4 个相邻格子, O(1);
+// 搜索用的队列, 来向和 visited 数组在 Reset 时按棋盘大小分配好; visited 存的是搜索的
+// 编号 (epoch), 每次搜索只需要把编号加一, 不需要清空数组, Decide 不分配内存
+// ------------------------------------------------------------------------------------
+
+typedef enum
+{
+    AUTOPILOT_BFS = 0, // 有回路时沿回路抄近路 (保证存活), 否则最短路径加安全检查
+    AUTOPILOT_CYCLE    // 只沿哈密顿回路走, 保证存活
+} AutopilotMode;
+
+// 宽或高为偶数的棋盘上存在哈密顿回路
+inline bool HasHamiltonianCycle(int width, int height)
+{
+    return width >= 2 && height >= 2 && (width % 2 == 0 || height % 2 == 0);
+}
+
+// 高度为偶数时: 第 0 列向上, 其余列逐行来回扫 (偶数行向右, 奇数行向左)
+inline SnakeDirection CycleDirectionEvenHeight(int x, int y, int width, int height)
+{
+    if (x == 0)
+        return y == 0 ? DIR_RIGHT : DIR_UP;
+    if (y % 2 == 0)
+        return x == width - 1 ? DIR_DOWN : DIR_RIGHT;
+    if (x == 1)
+        return y == height - 1 ? DIR_LEFT : DIR_DOWN;
+    return DIR_LEFT;
+}
+
+// 哈密顿回路上 position 的下一步; 只有高度为奇数 (宽度为偶数) 时转置处理
+inline SnakeDirection HamiltonianDirection(Cell position, int width, int height)
+{
+    if (height % 2 == 0)
+        return CycleDirectionEvenHeight(position.x, position.y, width, height);
+
+    // 转置: x 和 y 互换, 右 <-> 下, 左 <-> 上
+    static const SnakeDirection TRANSPOSED[4] = {DIR_DOWN, DIR_UP, DIR_LEFT, DIR_RIGHT};
+    return TRANSPOSED[CycleDirectionEvenHeight(position.y, position.x, height, width)];
+}
+
+// 高度为偶数时回路上的序号: (0, 0) 为 0, 然后逐行 (每行 x = 1 .. width - 1) 扫完, 最后沿第 0 列回到起点
+inline int CycleIndexEvenHeight(int x, int y, int width, int height)
+{
+    if (x == 0)
+        return y == 0 ? 0 : 1 + height * (width - 1) + (height - 1 - y);
+    const int rowStart = 1 + y * (width - 1);
+    return y % 2 == 0 ? rowStart + (x - 1) : rowStart + (width - 1 - x);
+}
+
+// position 在 HamiltonianDirection 这条回路上的序号 (0 .. width * height - 1)
+inline int HamiltonianIndex(Cell position, int width, int height)
+{
+    if (height % 2 == 0)
+        return CycleIndexEvenHeight(position.x, position.y, width, height);
+    return CycleIndexEvenHeight(position.y, position.x, height, width);
+}
+
+template <class Board>
+class BasicAutopilot
+{
+public:
+    BasicAutopilot(void);
+
+    void Reset(const Board &newBoard, AutopilotMode newMode); // 区域大小变化时才重新分配
+    AutopilotMode Mode(void) const { return mode; }
+
+    // 从开局起使用时是否保证不死 (棋盘上有哈密顿回路)
+    bool GuaranteesSurvival(void) const { return hasCycle; }
+    bool OnCycle(void) const { return onCycle; } // 蛇身已经按回路顺序排好, 之后的每一步都安全
+
+    SnakeDirection Decide(const BasicSimulation<Board> &sim);
+
+private:
+    typedef BasicSimulation<Board> Sim;
+
+    SnakeDirection DecideCycle(const Sim &sim);                     // 有回路的棋盘
+    SnakeDirection DecideShortcut(const Sim &sim, int headIndex) const; // 已经在回路上: 抄近路
+    SnakeDirection DecideBfs(const Sim &sim);                       // 没有回路的棋盘
+    SnakeDirection DecideFallback(const Sim &sim);
+    SnakeDirection CycleOrSafe(const Sim &sim) const;
+
+    int CycleIndex(Cell position) const { return HamiltonianIndex(position, board.Width(), board.Height()); }
+    int CycleDistance(int from, int to) const { return to >= from ? to - from : to - from + board.CellCount(); }
+
+    void BeginSearch(void);
+    bool FindPath(const Sim &sim, Cell start, Cell goal); // 找到时把路径写入 path
+    bool PathSafe(const Sim &sim);                        // 虚拟的蛇沿 path 吃到食物后能否走到尾巴
+    bool TailReachable(const Sim &sim, Cell start);       // 从 start 出发能否走到蛇尾
+
+    Board board;
+    AutopilotMode mode;
+    bool hasCycle;
+    uint32_t epoch; // 当前搜索的编号, visited[cell] == epoch 表示本次搜索已经访问过
+
+    typename Board::template CellArray<uint32_t> visited;
+    typename Board::template CellArray<uint32_t> virtualBody; // PathSafe 的虚拟蛇身, 同样按编号标记
+    typename Board::template CellArray<int32_t> frontier;     // BFS 队列, 每个格子最多入队一次
+    typename Board::template CellArray<uint8_t> cameFrom;     // 进入格子时的方向, 用于回溯路径
+    typename Board::template CellArray<uint8_t> path;         // 缓存的路径 (方向序列)
+
+    int pathLength;
+    int pathNext;  // 下一步在 path 中的位置
+    Cell pathHead; // 沿路径走时期望的蛇头位置, 不一致说明路径已经失效
+    Cell pathGoal; // 路径通向的食物
+    bool hasPath;
+
+    // 回路模式: 上一次决定之后期望的局面, 不一致 (玩家接管过, 换了一局) 时重新排队上回路
+    bool tracking;
+    bool onCycle;
+    uint64_t decidedTick;
+    int decidedIndex;  // 决定时蛇头在回路上的序号
+    Cell expectedHead; // 按决定的方向走一步后的蛇头
+    size_t cycleRun;   // 连续沿回路走的步数
+};
+
+template <class Board>
+BasicAutopilot<Board>::BasicAutopilot(void)
+    : board(), mode(AUTOPILOT_BFS), hasCycle(false), epoch(0), visited(), virtualBody(), frontier(), cameFrom(), path(),
+      pathLength(0), pathNext(0), pathHead{}, pathGoal{}, hasPath(false), tracking(false), onCycle(false),
+      decidedTick(0), decidedIndex(0), expectedHead{}, cycleRun(0)
+{
+}
+
+template <class Board>
+void BasicAutopilot<Board>::Reset(const Board &newBoard, AutopilotMode newMode)
+{
+    board = newBoard;
+    mode = newMode;
+    hasCycle = HasHamiltonianCycle(board.Width(), board.Height());
+    const size_t cellCount = (size_t)board.CellCount();
+    ResizeStorage(visited, cellCount);
+    ResizeStorage(virtualBody, hasCycle ? 0 : cellCount); // 只有没有回路时才做整条路径的检查
+    ResizeStorage(frontier, cellCount);
+    ResizeStorage(cameFrom, cellCount);
+    ResizeStorage(path, cellCount);
+    std::fill(visited.begin(), visited.end(), 0);
+    std::fill(virtualBody.begin(), virtualBody.end(), 0);
+    epoch = 0;
+    hasPath = false;
+    tracking = false;
+    onCycle = false;
+}
+
+template <class Board>
+SnakeDirection BasicAutopilot<Board>::Decide(const Sim &sim)
+{
+    if (!sim.Running())
+        return sim.Direction();
+
+    if (hasCycle)
+        return DecideCycle(sim);
+    return DecideBfs(sim);
+}
+
+template <class Board>
+SnakeDirection BasicAutopilot<Board>::DecideCycle(const Sim &sim)
+{
+    const auto &snake = sim.GetSnake();
+    const Cell head = snake.Head().position;
+    const int headIndex = CycleIndex(head);
+
+    // 蛇身里第 i 节就是 i 个 tick 之前的蛇头, 所以最近 Size() - 1 步都沿着回路时整条蛇就在回路上;
+    // 之后只走 DecideShortcut 选的格子, 顺序一直成立, 除非这中间有别人改过方向
+    if (!tracking || sim.Ticks() != decidedTick + 1 || head != expectedHead)
+    {
+        onCycle = false;
+        cycleRun = 0;
+    }
+    else if (CycleDistance(decidedIndex, headIndex) == 1)
+        cycleRun++;
+    else
+        cycleRun = 0;
+    if (!onCycle && cycleRun + 1 >= snake.Size())
+        onCycle = true;
+
+    SnakeDirection dir;
+    if (mode == AUTOPILOT_CYCLE)
+        dir = CycleOrSafe(sim);
+    else if (onCycle)
+        dir = DecideShortcut(sim, headIndex);
+    else
+        dir = DecideFallback(sim); // 优先沿回路, 尽快排好
+
+    tracking = true;
+    decidedTick = sim.Ticks();
+    decidedIndex = headIndex;
+    expectedHead = MoveCell(head, dir);
+    return dir;
+}
+
+// 蛇身在回路上占 [尾, 头] 这一段时, (头, 尾) 这一段全是空格: 在里面挑前进最多又不越过食物的相邻格子
+template <class Board>
+SnakeDirection BasicAutopilot<Board>::DecideShortcut(const Sim &sim, int headIndex) const
+{
+    const auto &snake = sim.GetSnake();
+    const Food &food = sim.GetFood();
+    const Cell head = snake.Head().position;
+    const int tailDistance = CycleDistance(headIndex, CycleIndex(snake.Tail().position));
+    // 食物在被跳过的空格里 (回路上位于蛇身那一段) 时最多追到尾巴后面, 等尾巴让开
+    const int foodDistance = food.active ? CycleDistance(headIndex, CycleIndex(food.position)) : 1;
+
+    // 回路上的下一格一定安全: 要么在空的那一段里, 要么是这个 tick 就会移走的尾巴
+    SnakeDirection best = HamiltonianDirection(head, board.Width(), board.Height());
+    int bestDistance = 1;
+    for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+    {
+        Cell next = MoveCell(head, (SnakeDirection)d);
+        if (!board.Contains(next))
+            continue;
+
+        const int distance = CycleDistance(headIndex, CycleIndex(next));
+        if (distance > bestDistance && distance < tailDistance && distance <= foodDistance)
+        {
+            best = (SnakeDirection)d;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+template <class Board>
+SnakeDirection BasicAutopilot<Board>::DecideBfs(const Sim &sim)
+{
+    const Cell head = sim.GetSnake().Head().position;
+    const Food &food = sim.GetFood();
+
+    // --- 沿用缓存的路径 ---
+    if (hasPath && head == pathHead && food.active && food.position == pathGoal && pathNext < pathLength)
+    {
+        SnakeDirection dir = (SnakeDirection)path[pathNext];
+        Cell next = MoveCell(head, dir);
+        if (!sim.IsDeadly(next))
+        {
+            pathNext++;
+            pathHead = next;
+            return dir;
+        }
+    }
+    hasPath = false;
+
+    // --- 重新搜索到食物的路径, 虚拟的蛇走完整条路径吃到食物以后还要能走到尾巴 ---
+    if (food.active && FindPath(sim, head, food.position) && PathSafe(sim))
+    {
+        SnakeDirection dir = (SnakeDirection)path[0];
+        Cell next = MoveCell(head, dir);
+        if (!sim.IsDeadly(next))
+        {
+            hasPath = true;
+            pathNext = 1;
+            pathHead = next;
+            pathGoal = food.position;
+            return dir;
+        }
+    }
+
+    return DecideFallback(sim);
+}
+
+// 没有安全的路径, 或者还没排到回路上: 选一个之后还能走到尾巴的方向 (有回路时优先回路的方向)
+template <class Board>
+SnakeDirection BasicAutopilot<Board>::DecideFallback(const Sim &sim)
+{
+    const Cell head = sim.GetSnake().Head().position;
+    const SnakeDirection preferred = hasCycle ? HamiltonianDirection(head, board.Width(), board.Height()) : sim.Direction();
+
+    // 先试偏好的方向, 再按枚举顺序试其余方向
+    SnakeDirection order[4];
+    int count = 0;
+    order[count++] = preferred;
+    for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+    {
+        if (d != preferred)
+            order[count++] = (SnakeDirection)d;
+    }
+
+    int fallback = -1;
+    for (SnakeDirection dir : order)
+    {
+        if (IsOpposite(dir, sim.Direction()))
+            continue;
+
+        Cell next = MoveCell(head, dir);
+        if (sim.IsDeadly(next))
+            continue;
+        if (TailReachable(sim, next))
+            return dir;
+        if (fallback < 0)
+            fallback = dir;
+    }
+    return fallback >= 0 ? (SnakeDirection)fallback : sim.Direction();
+}
+
+template <class Board>
+SnakeDirection BasicAutopilot<Board>::CycleOrSafe(const Sim &sim) const
+{
+    const Cell head = sim.GetSnake().Head().position;
+    SnakeDirection dir = HamiltonianDirection(head, board.Width(), board.Height());
+    if (!IsOpposite(dir, sim.Direction()) && !sim.IsDeadly(MoveCell(head, dir)))
+        return dir;
+
+    // 还没上回路 (例如开局时逆着回路): 先拐到任意一个安全的方向
+    for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+    {
+        SnakeDirection other = (SnakeDirection)d;
+        if (!IsOpposite(other, sim.Direction()) && !sim.IsDeadly(MoveCell(head, other)))
+            return other;
+    }
+    return sim.Direction();
+}
+
+template <class Board>
+void BasicAutopilot<Board>::BeginSearch(void)
+{
+    epoch++;
+    if (epoch == 0)
+    {
+        // 编号用完一轮 (四十多亿次搜索) 才需要真正清空
+        std::fill(visited.begin(), visited.end(), 0);
+        std::fill(virtualBody.begin(), virtualBody.end(), 0);
+        epoch = 1;
+    }
+}
+
+template <class Board>
+bool BasicAutopilot<Board>::FindPath(const Sim &sim, Cell start, Cell goal)
+{
+    const auto &snake = sim.GetSnake();
+    const Cell tail = snake.Tail().position;
+
+    BeginSearch();
+    int read = 0;
+    int write = 0;
+    visited[board.Index(start)] = epoch;
+    frontier[write++] = board.Index(start);
+
+    bool found = false;
+    while (read < write && !found)
+    {
+        Cell cell = board.FromIndex(frontier[read++]);
+        for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+        {
+            Cell next = MoveCell(cell, (SnakeDirection)d);
+            if (!board.Contains(next))
+                continue;
+
+            int index = board.Index(next);
+            if (visited[index] == epoch)
+                continue;
+            // 尾巴下一个 tick 就会移走, 可以通过
+            if (snake.IsOccupied(next) && next != tail)
+                continue;
+
+            visited[index] = epoch;
+            cameFrom[index] = (uint8_t)d;
+            if (next == goal)
+            {
+                found = true;
+                break;
+            }
+            frontier[write++] = index;
+        }
+    }
+    if (!found)
+        return false;
+
+    // 从终点沿来向回溯, 先数出长度再倒着写入
+    int length = 0;
+    for (Cell cell = goal; cell != start; length++)
+    {
+        cell = MoveCell(cell, (SnakeDirection)(cameFrom[board.Index(cell)] ^ 1));
+    }
+    int i = length;
+    for (Cell cell = goal; cell != start;)
+    {
+        uint8_t dir = cameFrom[board.Index(cell)];
+        path[--i] = dir;
+        cell = MoveCell(cell, (SnakeDirection)(dir ^ 1));
+    }
+    pathLength = length;
+    return true;
+}
+
+template <class Board>
+bool BasicAutopilot<Board>::PathSafe(const Sim &sim)
+{
+    const auto &snake = sim.GetSnake();
+    const int grown = (int)snake.Size() + 1; // 吃到食物长一节
+    if (grown >= board.CellCount())
+        return true; // 吃完就占满了棋盘
+
+    // 走完 path 以后的蛇身 (从头到尾): 路径上的格子倒过来, 再接上原来蛇身的前面几节
+    BeginSearch();
+    const uint32_t bodyEpoch = epoch;
+    const int keepPath = pathLength < grown ? pathLength : grown;
+    const int keepBody = grown - keepPath;
+
+    Cell cell = snake.Head().position;
+    Cell virtualTail = cell;
+    for (int i = 0; i < pathLength; i++)
+    {
+        cell = MoveCell(cell, (SnakeDirection)path[i]);
+        if (i == pathLength - keepPath)
+            virtualTail = cell;
+        if (i >= pathLength - keepPath)
+            virtualBody[board.Index(cell)] = bodyEpoch;
+    }
+    const Cell virtualHead = cell;
+    for (int i = 0; i < keepBody; i++)
+    {
+        virtualBody[board.Index(snake[(size_t)i].position)] = bodyEpoch;
+    }
+    if (keepBody > 0)
+        virtualTail = snake[(size_t)keepBody - 1].position;
+
+    // 吃到食物的那一步已经走完, 下一步尾巴会移走, 可以直接走进尾巴
+    BeginSearch();
+    int read = 0;
+    int write = 0;
+    visited[board.Index(virtualHead)] = epoch;
+    frontier[write++] = board.Index(virtualHead);
+
+    while (read < write)
+    {
+        Cell from = board.FromIndex(frontier[read++]);
+        for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+        {
+            Cell next = MoveCell(from, (SnakeDirection)d);
+            if (!board.Contains(next))
+                continue;
+            if (next == virtualTail)
+                return true;
+
+            int index = board.Index(next);
+            if (visited[index] == epoch || virtualBody[index] == bodyEpoch)
+                continue;
+
+            visited[index] = epoch;
+            frontier[write++] = index;
+        }
+    }
+    return false;
+}
+
+template <class Board>
+bool BasicAutopilot<Board>::TailReachable(const Sim &sim, Cell start)
+{
+    const auto &snake = sim.GetSnake();
+    const Food &food = sim.GetFood();
+    const Cell tail = snake.Tail().position;
+    if (start == tail)
+        return true;
+
+    // 走到 start 时吃到食物的话尾巴不会移走, 不能紧接着走进尾巴
+    const bool eating = food.active && start == food.position;
+
+    BeginSearch();
+    int read = 0;
+    int write = 0;
+    visited[board.Index(start)] = epoch;
+    frontier[write++] = board.Index(start);
+
+    while (read < write)
+    {
+        Cell cell = board.FromIndex(frontier[read++]);
+        for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+        {
+            Cell next = MoveCell(cell, (SnakeDirection)d);
+            if (!board.Contains(next))
+                continue;
+            if (next == tail && !(eating && cell == start))
+                return true;
+
+            int index = board.Index(next);
+            if (visited[index] == epoch || snake.IsOccupied(next))
+                continue;
+
+            visited[index] = epoch;
+            frontier[write++] = index;
+        }
+    }
+    return false;
+}
+
+// 常用的棋盘在 Autopilot.cpp 里显式实例化
+extern template class BasicAutopilot<DynamicBoard>;
+extern template class BasicAutopilot<ClassicBoard>;
+
+typedef BasicAutopilot<DynamicBoard> Autopilot;
+typedef BasicAutopilot<ClassicBoard> ClassicAutopilot;
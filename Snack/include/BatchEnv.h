@@ -0,0 +1,158 @@
+#pragma once
+
+#include "LaneKernel.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// BatchEnv: 同时推进很多局游戏 (用于训练和评测)
+// - 所有局的状态连续存放在一个数组里, 一次 Step 按块分给线程池并行推进
+// - 结束的局在同一次 Step 里原地重置, 调用方通过 EnvStepInfo 拿到这一局的结果
+// - 每局的蛇头, 方向和食物另外按 SoA 存一份, 新蛇头 / 撞墙 / 吃食物由 SIMD 内核成块算出,
+//   逐局只剩下查自身碰撞和移动蛇身
+// - 每局用自己的随机数流 (stream = 局号), 第几次开局混进种子里, 结果与线程数无关
+// ------------------------------------------------------------------------------------
+
+// 一局在一次 Step 里的结果
+struct EnvStepInfo
+{
+    int8_t reward;         // +1 吃到食物, -1 死亡, 0 其它
+    uint8_t done;          // 这一局在本次 Step 结束 (已经原地重置)
+    uint8_t won;           // 结束的原因是占满了棋盘
+    int32_t episodeScore;  // done 时为结束那一局的分数
+    uint32_t episodeTicks; // done 时为结束那一局的 tick 数
+};
+
+template <class Board>
+class BasicBatchEnv
+{
+public:
+    BasicBatchEnv(int gameCount, const Board &board, uint32_t seed, int threadCount = 0);
+
+    int Size(void) const { return (int)games.size(); }
+    const Board &GetBoard(void) const { return board; }
+    const BasicSimulation<Board> &Game(int index) const { return games[index]; }
+    ThreadPool &Pool(void) { return pool; }
+
+    void Reset(void); // 所有局重新开始
+
+    // 所有局各推进一个 tick; actions 和 infos 都有 Size() 个元素
+    void Step(const SnakeDirection *actions, EnvStepInfo *infos);
+
+    // 同上, 每局推进 (以及需要时重置) 之后立刻调用 observe(index, game), 趁状态还在缓存里
+    // 写观测; observe 会在线程池的各个线程上并发调用, 不同的 index 之间不能共享写入位置
+    template <class Observer>
+    void Step(const SnakeDirection *actions, EnvStepInfo *infos, Observer observe);
+
+    // 不推进, 对每一局并行调用 observe(index, game) (例如重置之后取第一帧观测)
+    template <class Observer>
+    void Observe(Observer observe);
+
+private:
+    struct NoObserver
+    {
+        void operator()(int, const BasicSimulation<Board> &) const {}
+    };
+
+    static const int GRAIN = 64; // 每个线程一次领取的局数 (16 的倍数, 块内都是整条向量)
+
+    template <class Observer>
+    void StepRange(int begin, int end, const SnakeDirection *actions, EnvStepInfo *infos, Observer &observe);
+    uint64_t EpisodeSeed(int index) const { return ((uint64_t)seed << 32) | episodes[index]; }
+
+    Board board;
+    uint32_t seed;
+    std::vector<BasicSimulation<Board>> games;
+    std::vector<uint32_t> episodes; // 每局已经开始过多少次
+    LaneBuffers lanes;
+    LaneKernel kernel;
+    ThreadPool pool;
+};
+
+template <class Board>
+BasicBatchEnv<Board>::BasicBatchEnv(int gameCount, const Board &batchBoard, uint32_t batchSeed, int threadCount)
+    : board(batchBoard), seed(batchSeed), games(gameCount), episodes(gameCount, 0),
+      kernel(SelectLaneKernel()), pool(threadCount)
+{
+    lanes.Resize(gameCount);
+    Reset();
+}
+
+template <class Board>
+void BasicBatchEnv<Board>::Reset(void)
+{
+    pool.ParallelFor(Size(), GRAIN, [this](int begin, int end) {
+        for (int i = begin; i < end; i++)
+        {
+            episodes[i] = 0;
+            games[i].Reset(board, EpisodeSeed(i), (uint64_t)i);
+            lanes.Load(i, games[i]);
+        }
+    });
+}
+
+template <class Board>
+void BasicBatchEnv<Board>::Step(const SnakeDirection *actions, EnvStepInfo *infos)
+{
+    Step(actions, infos, NoObserver());
+}
+
+template <class Board>
+template <class Observer>
+void BasicBatchEnv<Board>::Step(const SnakeDirection *actions, EnvStepInfo *infos, Observer observe)
+{
+    pool.ParallelFor(Size(), GRAIN, [&](int begin, int end) { StepRange(begin, end, actions, infos, observe); });
+}
+
+template <class Board>
+template <class Observer>
+void BasicBatchEnv<Board>::Observe(Observer observe)
+{
+    pool.ParallelFor(Size(), GRAIN, [&](int begin, int end) {
+        for (int i = begin; i < end; i++)
+            observe(i, games[i]);
+    });
+}
+
+template <class Board>
+template <class Observer>
+void BasicBatchEnv<Board>::StepRange(int begin, int end, const SnakeDirection *actions, EnvStepInfo *infos,
+                                     Observer &observe)
+{
+    const LaneState state = lanes.State();
+    const LaneResult move = lanes.Result();
+    kernel(state, actions, move, begin, end, board.Width(), board.Height());
+
+    for (int i = begin; i < end; i++)
+    {
+        BasicSimulation<Board> &game = games[i];
+        StepResult result = game.ApplyMove((SnakeDirection)state.direction[i], {move.nextX[i], move.nextY[i]},
+                                           move.hitWall[i] != 0, move.ateFood[i] != 0);
+
+        EnvStepInfo &info = infos[i];
+        info.reward = result.died ? -1 : (result.ateFood ? 1 : 0);
+        info.done = !game.Running();
+        info.won = result.won;
+        info.episodeScore = 0;
+        info.episodeTicks = 0;
+
+        if (info.done)
+        {
+            info.episodeScore = game.Score();
+            info.episodeTicks = (uint32_t)game.Ticks();
+            episodes[i]++;
+            game.Reset(board, EpisodeSeed(i), (uint64_t)i);
+        }
+        lanes.Load(i, game);
+        observe(i, game);
+    }
+}
+
+// 常用的棋盘在 BatchEnv.cpp 里显式实例化
+extern template class BasicBatchEnv<DynamicBoard>;
+extern template class BasicBatchEnv<ClassicBoard>;
+
+typedef BasicBatchEnv<DynamicBoard> BatchEnv;
+typedef BasicBatchEnv<ClassicBoard> ClassicBatchEnv;
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Cell.h"
+#include "Constants.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// Board: 棋盘大小和格子下标的换算规则, 作为模板参数传给 Snake / FoodSpawner / Simulation
+// - FixedBoard<W, H>: 编译期大小, 存储是 std::array, 宽度为 2 的幂时用移位计算下标,
+//   边界检查是和常量的比较
+// - DynamicBoard: 运行时大小的后备实现, 存储是 std::vector
+// ------------------------------------------------------------------------------------
+
+constexpr bool IsPowerOfTwo(int value) { return value > 0 && (value & (value - 1)) == 0; }
+constexpr int Log2(int value) { return (value <= 1) ? 0 : 1 + Log2(value >> 1); }
+
+template <int W, int H>
+struct FixedBoard
+{
+    static_assert(W >= 3 && H >= 1, "board too small for the initial snake");
+    static_assert(W <= INT16_MAX && H <= INT16_MAX, "cells store 16-bit coordinates");
+
+    static constexpr bool IS_FIXED = true;
+    static constexpr int CELL_COUNT = W * H;
+    static constexpr int WORD_COUNT = (CELL_COUNT + 63) / 64; // 占用位图的 64 位字数
+
+    template <class T>
+    using CellArray = std::array<T, CELL_COUNT>;
+    using Bitmap = std::array<uint64_t, WORD_COUNT>;
+
+    static constexpr int Width(void) { return W; }
+    static constexpr int Height(void) { return H; }
+    static constexpr int CellCount(void) { return CELL_COUNT; }
+
+    static constexpr int Index(Cell position)
+    {
+        if constexpr (IsPowerOfTwo(W))
+            return (position.y << Log2(W)) | position.x;
+        else
+            return position.y * W + position.x;
+    }
+
+    static constexpr Cell FromIndex(int index)
+    {
+        if constexpr (IsPowerOfTwo(W))
+            return {(int16_t)(index & (W - 1)), (int16_t)(index >> Log2(W))};
+        else
+            return {(int16_t)(index % W), (int16_t)(index / W)};
+    }
+
+    // 无符号比较同时排除负数, 两个比较的上界都是常量
+    static constexpr bool Contains(Cell position)
+    {
+        return (unsigned)position.x < (unsigned)W && (unsigned)position.y < (unsigned)H;
+    }
+};
+
+struct DynamicBoard
+{
+    static constexpr bool IS_FIXED = false;
+
+    template <class T>
+    using CellArray = std::vector<T>;
+    using Bitmap = std::vector<uint64_t>;
+
+    DynamicBoard(void) : width(0), height(0) {}
+    DynamicBoard(int boardWidth, int boardHeight) : width(boardWidth), height(boardHeight) {}
+
+    int Width(void) const { return width; }
+    int Height(void) const { return height; }
+    int CellCount(void) const { return width * height; }
+
+    int Index(Cell position) const { return position.y * width + position.x; }
+    Cell FromIndex(int index) const { return {(int16_t)(index % width), (int16_t)(index / width)}; }
+
+    bool Contains(Cell position) const
+    {
+        return (unsigned)position.x < (unsigned)width && (unsigned)position.y < (unsigned)height;
+    }
+
+    int width;
+    int height;
+};
+
+// 窗口版使用的棋盘
+typedef FixedBoard<GAME_AREA_WIDTH, GAME_AREA_HEIGHT> ClassicBoard;
+
+// 调整存储大小: std::vector 只在大小变化时重新分配, std::array 的大小在编译期已经确定
+template <class T>
+inline void ResizeStorage(std::vector<T> &storage, size_t size)
+{
+    storage.resize(size);
+}
+
+template <class T, size_t N>
+inline void ResizeStorage(std::array<T, N> &, size_t)
+{
+}
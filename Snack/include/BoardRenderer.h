@@ -0,0 +1,128 @@
+#pragma once
+
+#include "raylib.h"
+#include "Simulation.h"
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// BoardRenderer: 增量绘制棋盘
+// - 网格, 蛇身和食物保存在一张常驻的 RenderTexture2D 里, 每帧只需整张贴图一次
+// - 每个 tick 只重画发生变化的格子 (新的身体, 移走的蛇尾, 食物), 其余像素保持不变
+// - 只有重新开局或窗口大小变化时才完整重建: 网格线画一遍, 蛇身和食物写进
+//   "每个格子一个像素" 的纹理后一次画完
+// - 蛇头和刚移走的蛇尾需要插值, 每帧单独画成两个矩形
+// 与模拟状态相关的入口是模板, 任何 BasicSimulation<Board> 都可以直接传进来
+// ------------------------------------------------------------------------------------
+class BoardRenderer
+{
+public:
+    BoardRenderer(void);
+
+    void Load(int width, int height, int cellSize); // Create GPU resources (call after InitWindow)
+    void Unload(void);                              // Release GPU resources (call before CloseWindow)
+
+    void Invalidate(void) { fullRebuild = true; } // 重新开局后调用, 下次绘制前完整重建
+
+    template <class Sim>
+    void Apply(const Sim &sim, const StepResult &step); // 每个 tick 之后调用, 记录变化的格子
+
+    template <class Sim>
+    void Draw(const Sim &sim, const StepResult &lastStep, float alpha);
+
+private:
+    static const size_t MAX_DIRTY_CELLS = 64; // 一帧内积累的变化格子上限, 超过就完整重建
+
+    template <class Sim>
+    void FillPixels(const Sim &sim);
+    void Rebuild(void);
+    void Flush(void);
+    void MarkDirty(Cell position, Color color);
+    void PaintCell(Cell position, Color color) const;
+    void DrawMoving(const StepResult &lastStep, Cell head, Cell tail, float alpha) const;
+    void DrawCellLerp(Cell from, Cell to, float alpha, Color color) const;
+
+    struct DirtyCell
+    {
+        Cell position;
+        Color color;
+    };
+
+    RenderTexture2D board;        // 常驻的棋盘画面
+    Texture2D cells;              // 每个格子一个像素, 只在完整重建时使用
+    std::vector<Color> pixels;    // cells 在 CPU 端的副本
+    std::vector<DirtyCell> dirty; // 等待重画的格子
+    int width;
+    int height;
+    int cellSize;
+    bool fullRebuild;
+};
+
+template <class Sim>
+void BoardRenderer::Apply(const Sim &sim, const StepResult &step)
+{
+    if (fullRebuild || step.died)
+        return; // 反正要完整重建, 或者棋盘没有变化, 不用记录
+
+    if (dirty.size() + 3 > MAX_DIRTY_CELLS)
+    {
+        dirty.clear();
+        fullRebuild = true;
+        return;
+    }
+
+    // 蛇头每帧单独插值绘制; 旧的蛇头变成了身体
+    MarkDirty(step.prevHead, GREEN);
+    if (step.tailMoved)
+    {
+        MarkDirty(step.prevTail, BLANK);
+    }
+    if (step.ateFood)
+    {
+        MarkDirty(sim.GetSnake().Head().position, BLANK); // 食物被吃掉, 由蛇头覆盖
+        const Food &food = sim.GetFood();
+        if (food.active)
+            MarkDirty(food.position, RED);
+    }
+}
+
+template <class Sim>
+void BoardRenderer::FillPixels(const Sim &sim)
+{
+    const auto &snake = sim.GetSnake();
+    const Food &food = sim.GetFood();
+
+    for (Color &pixel : pixels)
+    {
+        pixel = BLANK;
+    }
+    // 蛇头单独插值绘制, 这里只写身体
+    for (size_t i = 1; i < snake.Size(); ++i)
+    {
+        Cell position = snake[i].position;
+        pixels[(size_t)position.y * width + position.x] = GREEN;
+    }
+    if (food.active)
+    {
+        pixels[(size_t)food.position.y * width + food.position.x] = RED;
+    }
+}
+
+template <class Sim>
+void BoardRenderer::Draw(const Sim &sim, const StepResult &lastStep, float alpha)
+{
+    if (IsWindowResized())
+        fullRebuild = true;
+
+    if (fullRebuild)
+    {
+        FillPixels(sim);
+        Rebuild();
+    }
+    else
+    {
+        Flush();
+    }
+
+    const auto &snake = sim.GetSnake();
+    DrawMoving(lastStep, snake.Head().position, snake.Tail().position, alpha);
+}
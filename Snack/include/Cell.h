@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// Cell: 格子坐标 (不是像素坐标)
+// 两个 16 位整数打包成 32 位, 只在绘制时才换算成像素
+// ------------------------------------------------------------------------------------
+struct Cell
+{
+    int16_t x;
+    int16_t y;
+};
+
+inline bool operator==(Cell a, Cell b) { return a.x == b.x && a.y == b.y; }
+inline bool operator!=(Cell a, Cell b) { return !(a == b); }
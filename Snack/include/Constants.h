@@ -0,0 +1,15 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------
+// Game Defines
+// 全部是 constexpr, 可以直接作为模板参数 (见 Board.h 的 FixedBoard)
+// ------------------------------------------------------------------------------------
+constexpr int SCREEN_WIDTH = 800;
+constexpr int SCREEN_HEIGHT = 600;
+constexpr int SQUARE_SIZE = 20; // 每个格子的大小
+constexpr int GAME_AREA_WIDTH = SCREEN_WIDTH / SQUARE_SIZE;
+constexpr int GAME_AREA_HEIGHT = SCREEN_HEIGHT / SQUARE_SIZE;
+constexpr int MAX_BOARD_SIZE = 4096; // 运行时棋盘每边最多的格子数, 超过一屏时由摄像机滚动显示
+
+constexpr unsigned MOVE_INTERVAL_MICROS = 150000; // 蛇移动的默认时间间隔 (微秒), 即一个模拟 tick; 见 Speed.h
+constexpr int MAX_STEPS_PER_FRAME = 8; // 一帧最多追赶的 tick 数, 防止卡顿后雪崩
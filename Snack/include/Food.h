@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Board.h"
+#include "Cell.h"
+#include "Random.h"
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// Food Structures
+// ------------------------------------------------------------------------------------
+struct Food
+{
+    Cell position; // 格子坐标
+    bool active;
+};
+
+// 空闲格子索引: 把所有格子排成一个排列, 前 freeCount 个是没有被蛇占用的格子
+// Occupy / Release 通过交换维护这个划分 (swap-remove), 都是 O(1);
+// Spawn 只需在前 freeCount 个里随机挑一个, 不会因为棋盘变满而重试
+template <class Board>
+class BasicFoodSpawner
+{
+public:
+    BasicFoodSpawner(void) : freeCount(0), board(), cells(), slotOf() {}
+
+    void Reset(const Board &newBoard); // 所有格子都标记为空闲, 区域大小变化时才重新分配
+    void Occupy(Cell position);        // 格子被蛇占用
+    void Release(Cell position);       // 格子重新变为空闲
+
+    int FreeCount(void) const { return freeCount; }
+
+    // 在一个随机的空闲格子上生成食物; 没有空闲格子 (棋盘已满) 时返回 false, food 置为不活跃
+    bool Spawn(Food &food, Pcg32 &rng) const;
+
+private:
+    void Swap(int slotA, int slotB);
+
+    int freeCount;
+    Board board;
+    typename Board::template CellArray<int32_t> cells;  // 格子下标的排列, [0, freeCount) 为空闲格子
+    typename Board::template CellArray<int32_t> slotOf; // 每个格子在 cells 中的位置
+};
+
+template <class Board>
+void BasicFoodSpawner<Board>::Reset(const Board &newBoard)
+{
+    board = newBoard;
+    int cellCount = board.CellCount();
+    ResizeStorage(cells, (size_t)cellCount);
+    ResizeStorage(slotOf, (size_t)cellCount);
+    for (int i = 0; i < cellCount; i++)
+    {
+        cells[i] = i;
+        slotOf[i] = i;
+    }
+    freeCount = cellCount;
+}
+
+template <class Board>
+void BasicFoodSpawner<Board>::Occupy(Cell position)
+{
+    // 把该格子换到空闲区间的末尾, 然后缩小空闲区间
+    int slot = slotOf[board.Index(position)];
+    if (slot < freeCount)
+    {
+        Swap(slot, freeCount - 1);
+        freeCount--;
+    }
+}
+
+template <class Board>
+void BasicFoodSpawner<Board>::Release(Cell position)
+{
+    // 把该格子换到空闲区间之后的第一个位置, 然后扩大空闲区间
+    int slot = slotOf[board.Index(position)];
+    if (slot >= freeCount)
+    {
+        Swap(slot, freeCount);
+        freeCount++;
+    }
+}
+
+template <class Board>
+bool BasicFoodSpawner<Board>::Spawn(Food &food, Pcg32 &rng) const
+{
+    if (freeCount == 0)
+    {
+        food.active = false;
+        return false;
+    }
+
+    food.position = board.FromIndex(cells[rng.Bounded((uint32_t)freeCount)]);
+    food.active = true;
+    return true;
+}
+
+template <class Board>
+void BasicFoodSpawner<Board>::Swap(int slotA, int slotB)
+{
+    int cellA = cells[slotA];
+    int cellB = cells[slotB];
+    cells[slotA] = cellB;
+    cells[slotB] = cellA;
+    slotOf[cellA] = slotB;
+    slotOf[cellB] = slotA;
+}
+
+// 常用的棋盘在 Food.cpp 里显式实例化
+extern template class BasicFoodSpawner<DynamicBoard>;
+extern template class BasicFoodSpawner<ClassicBoard>;
+
+typedef BasicFoodSpawner<DynamicBoard> FoodSpawner;
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Screen.h"
+#include "MenuScreen.h"
+#include "OptionSreen.h"
+#include "PlayScreen.h"
+#include "VersusScreen.h"
+#include "OnlineScreen.h"
+#include "GameOverScreen.h"
+#include "StatsStore.h"
+
+// 可以在选项画面里修改的设置
+struct GameOptions
+{
+    bool soundEnabled;
+    int boardWidth; // 棋盘大小 (格子数), 超过一屏时摄像机跟随蛇头
+    int boardHeight;
+    int speedCurve; // SpeedCurveId: 单人模式的 tick 间隔怎样随吃到的食物缩短
+};
+
+// ------------------------------------------------------------------------------------
+// Game: 窗口, 音频和画面状态机
+// 所有画面在启动时构造一次, 用一个固定深度的栈管理切换 (例如在菜单之上打开选项)
+// ------------------------------------------------------------------------------------
+class Game
+{
+public:
+    Game(void);
+
+    void Run(void); // Open the window, run the main loop, close everything on exit
+
+    void ChangeScreen(ScreenId id); // 替换当前画面
+    void PushScreen(ScreenId id);   // 在当前画面之上打开一个画面
+    void PopScreen(void);           // 关闭当前画面, 回到下面的画面
+    void Quit(void) { running = false; }
+
+    GameOptions &Options(void) { return options; }
+    const GameOptions &Options(void) const { return options; }
+
+    // 持久化的战绩和排行榜 (启动时读入, 写盘在后台线程)
+    StatsStore &Stats(void) { return stats; }
+    const StatsStore &Stats(void) const { return stats; }
+
+    // 上一局的结果: PlayScreen / VersusScreen 写入, GameOverScreen 读取
+    void SetLastResult(int score, bool won, int rank); // rank 是排行榜上的名次, 没进榜为 -1
+    void SetLastVersusResult(int winner, int winnerScore); // winner 为 -1 表示平局
+    int LastScore(void) const { return lastScore; }
+    bool LastWon(void) const { return lastWon; }
+    bool LastVersus(void) const { return lastVersus; }
+    int LastWinner(void) const { return lastWinner; }
+    int LastRank(void) const { return lastRank; }
+
+private:
+    static const int MAX_SCREEN_DEPTH = 4;
+
+    Screen *Top(void) const { return stack[depth - 1]; }
+
+    MenuScreen menuScreen;
+    OptionScreen optionScreen;
+    PlayScreen playScreen;
+    VersusScreen versusScreen;
+    OnlineScreen onlineScreen;
+    GameOverScreen gameOverScreen;
+    Screen *screens[SCREEN_COUNT]; // 按 ScreenId 查找画面
+
+    Screen *stack[MAX_SCREEN_DEPTH];
+    int depth;
+
+    GameOptions options;
+    bool running;
+    int lastScore;
+    bool lastWon;
+    bool lastVersus; // 上一局是不是双人对战 (决定结束画面的文字和重新开始回到哪里)
+    int lastWinner;
+    int lastRank;
+
+    StatsStore stats;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Screen.h"
+#include "StatsStore.h"
+#include "TextCache.h"
+
+// ------------------------------------------------------------------------------------
+// GameOverScreen: 一局结束后的画面 (失败或占满棋盘; 双人对战时显示赢家或平局)
+// 固定的文字预先光栅化, 分数只在变化时重新格式化和测量
+// 单人模式下显示排行榜 (来自 StatsStore 的内存索引), 名次和累计统计只在进入画面时格式化一次
+// ------------------------------------------------------------------------------------
+class GameOverScreen : public Screen
+{
+public:
+    GameOverScreen(void);
+
+    void Load(void) override;
+    void Unload(void) override;
+    void Enter(Game &game) override;
+    void Update(Game &game, float frameTime) override;
+    void Draw(const Game &game) override;
+
+private:
+    StaticLabel gameOverLabel;
+    StaticLabel winLabel;
+    StaticLabel playerWinLabels[2]; // VersusScreen 的两名玩家
+    StaticLabel drawLabel;
+    StaticLabel restartLabel;
+    CachedNumberText scoreText;
+
+    StaticLabel leaderboardLabel;
+    char rowTexts[StatsStore::LEADERBOARD_SIZE][64]; // "1.   120   length 15   0:42"
+    int rowWidths[StatsStore::LEADERBOARD_SIZE];
+    int rowCount;
+    char totalsText[96];                             // 累计的局数, 时长和最长的蛇
+    int totalsWidth;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Simulation.h"
+#include <cstdint>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// LaneKernel: 批量模式的 SIMD 内核, 数据按 SoA 排列 (每个数组的第 i 个元素属于第 i 局)
+// 一次算出很多局的新方向, 新蛇头, 是否撞墙和是否吃到食物, 逻辑和 Simulation::Step 一致:
+// - 与当前方向相反的输入被忽略
+// - 按方向移动一格, 越界即撞墙
+// - 新蛇头和食物坐标相同即吃到 (没有食物的局食物坐标记为 -1)
+// 撞到自己需要查各局的占用位图, 留给逐局的 ApplyMove 处理
+//
+// 坐标用 int16, AVX2 一条指令处理 16 局, NEON 处理 8 局; 启动时按 CPU 选择实现,
+// 不支持的平台走标量版本
+// ------------------------------------------------------------------------------------
+
+// 内核读写的 SoA 数组, 长度都是局数
+struct LaneState
+{
+    int16_t *headX;     // 蛇头
+    int16_t *headY;
+    int16_t *direction; // SnakeDirection, 内核写回过滤掉 180 度转向之后的方向
+    int16_t *foodX;     // 食物, 没有食物时为 -1
+    int16_t *foodY;
+};
+
+// 内核的输出
+struct LaneResult
+{
+    int16_t *nextX; // 新蛇头
+    int16_t *nextY;
+    int16_t *hitWall; // 0 / 1
+    int16_t *ateFood; // 0 / 1
+};
+
+// 处理 [begin, end) 这些局; actions 是每局的输入方向
+typedef void (*LaneKernel)(const LaneState &state, const SnakeDirection *actions, const LaneResult &result,
+                           int begin, int end, int width, int height);
+
+void StepLanesScalar(const LaneState &state, const SnakeDirection *actions, const LaneResult &result,
+                     int begin, int end, int width, int height);
+
+LaneKernel SelectLaneKernel(void); // 按当前 CPU 选择最快的实现 (结果会缓存)
+const char *LaneKernelName(void);  // "avx2" / "neon" / "scalar"
+
+// 持有 SoA 数组的存储
+class LaneBuffers
+{
+public:
+    void Resize(int count);
+
+    LaneState State(void);
+    LaneResult Result(void);
+
+    // 用一局的当前状态刷新第 index 条 lane
+    template <class Board>
+    void Load(int index, const BasicSimulation<Board> &sim)
+    {
+        const Cell head = sim.GetSnake().Head().position;
+        const Food &food = sim.GetFood();
+        headX[index] = head.x;
+        headY[index] = head.y;
+        direction[index] = (int16_t)sim.Direction();
+        foodX[index] = food.active ? food.position.x : (int16_t)-1;
+        foodY[index] = food.active ? food.position.y : (int16_t)-1;
+    }
+
+private:
+    std::vector<int16_t> headX, headY, direction, foodX, foodY;
+    std::vector<int16_t> nextX, nextY, hitWall, ateFood;
+};
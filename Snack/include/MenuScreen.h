@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Screen.h"
+#include "TextCache.h"
+
+// ------------------------------------------------------------------------------------
+// MenuScreen: 主菜单 (开始游戏, 本地双人对战, 选项, 退出)
+// ------------------------------------------------------------------------------------
+class MenuScreen : public Screen
+{
+public:
+    MenuScreen(void);
+
+    void Load(void) override;
+    void Unload(void) override;
+    void Enter(Game &game) override;
+    void Update(Game &game, float frameTime) override;
+    void Draw(const Game &game) override;
+
+private:
+    enum
+    {
+        ITEM_PLAY = 0,
+        ITEM_VERSUS,
+        ITEM_ONLINE,
+        ITEM_OPTIONS,
+        ITEM_QUIT,
+        ITEM_COUNT
+    };
+
+    StaticLabel titleLabel;
+    StaticLabel itemLabels[ITEM_COUNT];
+    int selected;
+};
@@ -0,0 +1,395 @@
+#pragma once
+
+#include "Board.h"
+#include "Cell.h"
+#include "Food.h"
+#include "Random.h"
+#include "Simulation.h"
+#include "Snacke.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// ------------------------------------------------------------------------------------
+// MultiSimulation: 同一个棋盘上的多条蛇 (本地分屏键盘对战, 或者由服务器推进的联网对战)
+// 调用方每个 tick 传入所有玩家的方向, 结果只由 (seed, stream) 和输入序列决定
+//
+// 碰撞统一查一张共享的 owner 网格 (每个格子 1 字节: 0 为空, 否则是占用它的玩家 + 1),
+// 不做蛇与蛇之间的逐段比较; 一个 tick 分四遍, 每遍每条蛇只做 O(1) 的工作:
+// 1. 算出新方向和新蛇头, 撞墙的直接死亡
+// 2. 不吃食物的蛇先移走尾巴, 包括自己在内的任何蛇都可以跟进这个格子
+// 3. 在网格上认领新蛇头: 格子已经是身体则撞身体; 已经被本 tick 的另一个蛇头认领则双方都死
+// 4. 活下来的蛇把认领变成蛇头, 死掉的蛇从棋盘上移除 (只在死亡时花 O(长度))
+// 所以每个 tick 的代价是 O(蛇的数量), 与蛇的长度无关
+// ------------------------------------------------------------------------------------
+
+constexpr int MAX_PLAYERS = 4;
+
+// 一个 tick 中发生的事件
+struct MultiStepResult
+{
+    StepResult players[MAX_PLAYERS]; // 每条蛇的事件, 含义与单人模式相同
+    int deaths;                      // 本 tick 死亡的蛇数
+};
+
+template <class Board>
+class alignas(64) BasicMultiSimulation
+{
+public:
+    BasicMultiSimulation(void);
+
+    // 开始新的一局; 调用方保证棋盘宽度至少为 8, 高度大于 playerCount
+    // 蛇在不同的行上出生, 偶数号从左边向右, 奇数号从右边向左 (只有一名玩家时和单人模式一样)
+    void Reset(const Board &newBoard, int playerCount, uint64_t seed, uint64_t stream = 0);
+
+    // 所有蛇同时推进一个 tick; inputs 有 PlayerCount() 个元素, 死掉的蛇的输入被忽略
+    MultiStepResult Step(const SnakeDirection *inputs);
+
+    // 联网客户端从服务器的关键帧重建状态: 先 Restore 清空棋盘, 再逐条 RestoreSnake
+    // (body 从蛇头到蛇尾), 最后 PlaceFood; 之后用服务器下发的方向 Step, 食物位置总是
+    // 由 PlaceFood 采用服务器的结果, 所以副本不需要和服务器有同样的随机数状态
+    void Restore(const Board &newBoard, int playerCount, uint64_t ticks, SimStatus status, int winner);
+    void RestoreSnake(int player, const Cell *body, int length, SnakeDirection direction, int score, bool alive);
+    void PlaceFood(const Food &newFood) { food = newFood; }
+
+    const Board &GetBoard(void) const { return board; }
+    int Width(void) const { return board.Width(); }
+    int Height(void) const { return board.Height(); }
+    SimStatus Status(void) const { return status; }
+    bool Running(void) const { return status == SIM_RUNNING; }
+    uint64_t Ticks(void) const { return ticks; }
+    int PlayerCount(void) const { return playerCount; }
+    int AliveCount(void) const { return aliveCount; }
+
+    // 结束时的赢家: 多人时是最后活下来的蛇 (占满棋盘时是分数最高的), 单人时是占满了棋盘;
+    // 没有赢家 (同归于尽或平分) 时为 -1
+    int Winner(void) const { return winner; }
+
+    bool Alive(int player) const { return players[player].alive; }
+    SnakeDirection Direction(int player) const { return players[player].direction; }
+    int Score(int player) const { return players[player].score; }
+    const BasicSnake<Board> &GetSnake(int player) const { return players[player].snake; }
+    const Food &GetFood(void) const { return food; }
+
+    bool InBounds(Cell position) const { return board.Contains(position); }
+
+    // 占用这个格子的玩家, 空格子为 -1; 调用方保证坐标在棋盘内
+    int Owner(Cell position) const { return (int)owner[board.Index(position)] - 1; }
+
+    // 蛇头移动到这个格子是否可能会死 (撞墙, 或者撞到不是蛇尾的身体;
+    // 对手的蛇头同时进入同一个格子的情况无法提前知道)
+    bool IsDeadly(Cell position) const
+    {
+        if (!board.Contains(position))
+            return true;
+        int player = Owner(position);
+        return player >= 0 && position != players[player].snake.Tail().position;
+    }
+
+private:
+    static const uint8_t CLAIM = 0x80; // 第 3 遍里 "本 tick 被这个玩家的蛇头认领" 的标记
+
+    struct Player
+    {
+        BasicSnake<Board> snake;
+        SnakeDirection direction;
+        int score;
+        bool alive;
+    };
+
+    void PushHead(int player, Cell position); // Grow a snake at the head, keeping owner grid and free cells in sync
+    void PopTail(int player);                 // Drop a snake's tail cell, keeping owner grid and free cells in sync
+    void RemoveSnake(int player);             // Clear a dead snake's body from the board
+    void Finish(SimStatus finalStatus);       // End the round and decide the winner
+
+    SimStatus status;
+    int playerCount;
+    int aliveCount;
+    int winner;
+    uint64_t ticks;
+    Food food;
+    Board board;
+    Player players[MAX_PLAYERS];
+    typename Board::template CellArray<uint8_t> owner; // 共享的 owner 网格
+    BasicFoodSpawner<Board> foodSpawner;               // 所有蛇共用的空闲格子索引
+    Pcg32 rng;                                         // 只用于生成食物
+};
+
+template <class Board>
+BasicMultiSimulation<Board>::BasicMultiSimulation(void)
+    : status(SIM_DEAD), playerCount(0), aliveCount(0), winner(-1), ticks(0), food{}, board(), players(), owner()
+{
+}
+
+template <class Board>
+void BasicMultiSimulation<Board>::Reset(const Board &newBoard, int newPlayerCount, uint64_t seed, uint64_t stream)
+{
+    board = newBoard;
+    rng.Seed(seed, stream);
+    status = SIM_RUNNING;
+    playerCount = (newPlayerCount < 1) ? 1 : (newPlayerCount > MAX_PLAYERS ? MAX_PLAYERS : newPlayerCount);
+    aliveCount = playerCount;
+    winner = -1;
+    ticks = 0;
+
+    const int width = board.Width();
+    const int height = board.Height();
+
+    ResizeStorage(owner, (size_t)board.CellCount());
+    std::fill(owner.begin(), owner.end(), (uint8_t)0);
+    foodSpawner.Reset(board);
+
+    for (int p = 0; p < playerCount; p++)
+    {
+        Player &player = players[p];
+        player.snake.Reset(board);
+        player.direction = (p % 2 == 0) ? DIR_RIGHT : DIR_LEFT;
+        player.score = 0;
+        player.alive = true;
+
+        // 从蛇尾往蛇头依次压入, 沿出生方向排成三节
+        const int16_t y = (int16_t)((playerCount == 1) ? height / 2 : (p + 1) * height / (playerCount + 1));
+        const int16_t x = (int16_t)((playerCount == 1) ? width / 2 : (p % 2 == 0 ? width / 4 : width - 1 - width / 4));
+        const int16_t back = (player.direction == DIR_RIGHT) ? -1 : 1;
+        PushHead(p, {(int16_t)(x + 2 * back), y});
+        PushHead(p, {(int16_t)(x + back), y});
+        PushHead(p, {x, y});
+    }
+
+    foodSpawner.Spawn(food, rng);
+}
+
+template <class Board>
+MultiStepResult BasicMultiSimulation<Board>::Step(const SnakeDirection *inputs)
+{
+    MultiStepResult result = {};
+    if (status != SIM_RUNNING)
+        return result;
+
+    ticks++;
+    Cell next[MAX_PLAYERS];
+    bool moving[MAX_PLAYERS] = {}; // 活着并且没有撞墙, 参与后面几遍
+
+    // --- 第 1 遍: 新方向和新蛇头, 撞墙的直接死亡 ---
+    for (int p = 0; p < playerCount; p++)
+    {
+        Player &player = players[p];
+        if (!player.alive)
+            continue;
+
+        StepResult &step = result.players[p];
+        if (!IsOpposite(inputs[p], player.direction)) // 防止 180 度转向
+            player.direction = inputs[p];
+        step.prevHead = player.snake.Head().position;
+        next[p] = MoveCell(step.prevHead, player.direction);
+        if (!board.Contains(next[p]))
+        {
+            step.died = true;
+            continue;
+        }
+        moving[p] = true;
+        step.ateFood = food.active && next[p] == food.position;
+    }
+
+    // --- 第 2 遍: 不吃食物的蛇先移走尾巴 ---
+    for (int p = 0; p < playerCount; p++)
+    {
+        StepResult &step = result.players[p];
+        if (moving[p] && !step.ateFood)
+        {
+            step.tailMoved = true;
+            step.prevTail = players[p].snake.Tail().position;
+            PopTail(p);
+        }
+    }
+
+    // --- 第 3 遍: 认领新蛇头 ---
+    for (int p = 0; p < playerCount; p++)
+    {
+        if (!moving[p])
+            continue;
+
+        uint8_t &cell = owner[board.Index(next[p])];
+        if (cell == 0)
+        {
+            cell = (uint8_t)(CLAIM | p);
+            continue;
+        }
+        result.players[p].died = true;
+        if (cell & CLAIM)
+            result.players[cell & ~CLAIM].died = true; // 两个蛇头撞在一起, 同归于尽
+    }
+
+    // --- 第 4 遍: 认领变成蛇头, 死掉的蛇移出棋盘 ---
+    int eater = -1;
+    for (int p = 0; p < playerCount; p++)
+    {
+        StepResult &step = result.players[p];
+        if (moving[p])
+        {
+            uint8_t &cell = owner[board.Index(next[p])];
+            if (!step.died)
+                PushHead(p, next[p]);
+            else if (cell & CLAIM)
+                cell = 0; // 同归于尽的格子重新变空 (撞身体的蛇没有认领, 格子还是别人的身体)
+        }
+
+        if (step.died)
+        {
+            step.ateFood = false;
+            players[p].alive = false;
+            RemoveSnake(p);
+            aliveCount--;
+            result.deaths++;
+        }
+        else if (step.ateFood)
+        {
+            eater = p; // 只有一个食物, 最多一条蛇吃到
+        }
+    }
+
+    if (eater >= 0)
+    {
+        players[eater].score += 10;
+        if (!foodSpawner.Spawn(food, rng))
+        {
+            Finish(SIM_WON); // 没有空闲格子, 棋盘已经占满
+            if (winner >= 0)
+                result.players[winner].won = true;
+            return result;
+        }
+    }
+
+    // 多人时剩下一条蛇就结束, 单人时蛇死了才结束
+    if (aliveCount < ((playerCount > 1) ? 2 : 1))
+    {
+        Finish(SIM_DEAD);
+    }
+    return result;
+}
+
+template <class Board>
+void BasicMultiSimulation<Board>::PushHead(int player, Cell position)
+{
+    players[player].snake.PushHead({position});
+    owner[board.Index(position)] = (uint8_t)(player + 1);
+    foodSpawner.Occupy(position);
+}
+
+template <class Board>
+void BasicMultiSimulation<Board>::PopTail(int player)
+{
+    BasicSnake<Board> &snake = players[player].snake;
+    Cell position = snake.Tail().position;
+    owner[board.Index(position)] = 0;
+    foodSpawner.Release(position);
+    snake.PopTail();
+}
+
+template <class Board>
+void BasicMultiSimulation<Board>::RemoveSnake(int player)
+{
+    const BasicSnake<Board> &snake = players[player].snake;
+    for (size_t i = 0; i < snake.Size(); i++)
+    {
+        Cell position = snake[i].position;
+        owner[board.Index(position)] = 0;
+        foodSpawner.Release(position);
+    }
+}
+
+template <class Board>
+void BasicMultiSimulation<Board>::Finish(SimStatus finalStatus)
+{
+    status = finalStatus;
+    winner = -1;
+
+    // 活着的蛇里分数最高的获胜, 平分则没有赢家; 单人时只有占满棋盘才算赢
+    if (playerCount == 1)
+    {
+        winner = (finalStatus == SIM_WON) ? 0 : -1;
+        return;
+    }
+    int bestScore = -1;
+    int bestCount = 0;
+    for (int p = 0; p < playerCount; p++)
+    {
+        if (!players[p].alive)
+            continue;
+        if (players[p].score > bestScore)
+        {
+            bestScore = players[p].score;
+            bestCount = 1;
+            winner = p;
+        }
+        else if (players[p].score == bestScore)
+        {
+            bestCount++;
+        }
+    }
+    if (bestCount != 1)
+        winner = -1;
+}
+
+template <class Board>
+void BasicMultiSimulation<Board>::Restore(const Board &newBoard, int newPlayerCount, uint64_t newTicks,
+                                          SimStatus newStatus, int newWinner)
+{
+    board = newBoard;
+    rng.Seed(0, 0);
+    status = newStatus;
+    playerCount = (newPlayerCount < 1) ? 1 : (newPlayerCount > MAX_PLAYERS ? MAX_PLAYERS : newPlayerCount);
+    aliveCount = 0;
+    winner = newWinner;
+    ticks = newTicks;
+    food = Food{};
+
+    ResizeStorage(owner, (size_t)board.CellCount());
+    std::fill(owner.begin(), owner.end(), (uint8_t)0);
+    foodSpawner.Reset(board);
+    for (int p = 0; p < playerCount; p++)
+    {
+        players[p].snake.Reset(board);
+        players[p].direction = DIR_RIGHT;
+        players[p].score = 0;
+        players[p].alive = false;
+    }
+}
+
+template <class Board>
+void BasicMultiSimulation<Board>::RestoreSnake(int player, const Cell *body, int length, SnakeDirection direction,
+                                               int score, bool alive)
+{
+    Player &restored = players[player];
+    restored.direction = direction;
+    restored.score = score;
+    restored.alive = alive;
+    if (!alive)
+        return; // 死掉的蛇不在棋盘上
+
+    aliveCount++;
+    for (int i = length - 1; i >= 0; i--)
+    {
+        PushHead(player, body[i]);
+    }
+}
+
+// 复制一局对战的全部状态 (快照 / 恢复); 编译期大小的棋盘直接 memcpy
+template <class Board>
+inline void CopyState(BasicMultiSimulation<Board> &destination, const BasicMultiSimulation<Board> &source)
+{
+    if constexpr (std::is_trivially_copyable<BasicMultiSimulation<Board>>::value)
+        memcpy((void *)&destination, (const void *)&source, sizeof(source));
+    else
+        destination = source;
+}
+
+// 常用的棋盘在 MultiSimulation.cpp 里显式实例化
+extern template class BasicMultiSimulation<DynamicBoard>;
+extern template class BasicMultiSimulation<ClassicBoard>;
+
+typedef BasicMultiSimulation<DynamicBoard> MultiSimulation;
+typedef BasicMultiSimulation<ClassicBoard> ClassicMultiSimulation; // 本地对战用的 40x30 棋盘
+
+static_assert(std::is_trivially_copyable<ClassicMultiSimulation>::value, "fixed-board state must be memcpy-able");
@@ -0,0 +1,389 @@
+#pragma once
+
+#include "MultiSimulation.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// NetProtocol: 联网对战的二进制协议 (UDP, 小端), 不依赖 socket, 服务器和客户端共用
+//
+// 服务器是权威的: 它按固定 tick 推进每个房间的 MultiSimulation, 每个 tick 只广播变化
+// - 每条蛇 1 字节: 实际生效的方向 (2 bit, 新蛇头 = 旧蛇头沿这个方向走一格),
+//   是否移走了蛇尾, 是否死亡, 是否吃到食物
+// - 生成了新食物时附带食物的格子
+// 客户端用同样的方向推进自己的副本 (NetReplica), 食物直接采用服务器的位置,
+// 所以副本和服务器逐 tick 一致, 而每个 tick 只需要几个字节
+//
+// 每个数据报带上最近 NET_DELTA_REDUNDANCY 个 tick 的 delta, 偶尔丢包不需要重传;
+// 每局开始时和每隔 NET_KEYFRAME_INTERVAL 个 tick 发一个关键帧 (完整的蛇身, 每节 2 bit),
+// 中途加入或者连续丢包的客户端从关键帧恢复
+//
+// 数据报格式 (第一个字节是 NetMessageType):
+//   JOIN      | version u8 | room u32                       (room 为 NET_ANY_ROOM 时由服务器分配)
+//   INPUT     | tick u32 | direction u8                    (客户端每个 tick 发送当前方向, 兼作心跳)
+//             tick 是这个方向生效的 tick (推进之后的 Ticks()): 做预测的客户端领先服务器,
+//             提前到达的输入排在那个 tick 生效; 晚到的在服务器的下一个 tick 生效
+//   LEAVE     |
+//   WELCOME   | room u32 | player u8 | playerCount u8
+//   ROOM_FULL | room u32
+//   KEYFRAME  | room u32 | round u16 | tick u32 | status u8 | winner i8 | playerCount u8
+//             | food x i16 | food y i16 | food active u8
+//             | 每条蛇: alive u8 | direction u8 | score i32 | length u16 | head x i16 | head y i16
+//             | 蛇身: 从蛇头开始每一节相对前一节的方向, 每节 2 bit, 按字节补齐
+//   DELTAS    | room u32 | round u16 | playerCount u8 | firstTick u32 | count u8
+//             | count 个 (按 tick 递增): flags u8 | 每条蛇 1 字节 | [food x i16 | food y i16]
+// ------------------------------------------------------------------------------------
+
+constexpr uint8_t NET_PROTOCOL_VERSION = 1;
+constexpr uint32_t NET_ANY_ROOM = 0xffffffffu;
+constexpr size_t NET_MAX_DATAGRAM = 1200;      // 不会在常见链路上分片的大小
+constexpr int NET_DELTA_REDUNDANCY = 4;        // 每个数据报重复携带的 delta 数
+constexpr uint32_t NET_KEYFRAME_INTERVAL = 64; // 两个关键帧之间的 tick 数
+constexpr uint32_t NET_INPUT_WINDOW = 32;      // 服务器最多提前排队多少个 tick 的输入
+
+typedef enum
+{
+    NET_JOIN = 1,
+    NET_INPUT,
+    NET_LEAVE,
+    NET_WELCOME,
+    NET_ROOM_FULL,
+    NET_KEYFRAME,
+    NET_DELTAS
+} NetMessageType;
+
+// delta 里每条蛇的字节
+constexpr uint8_t NET_DIRECTION_MASK = 0x03;
+constexpr uint8_t NET_TAIL_MOVED = 0x04;
+constexpr uint8_t NET_DIED = 0x08;
+constexpr uint8_t NET_ATE_FOOD = 0x10;
+
+// delta 的 flags
+constexpr uint8_t NET_FOOD_EVENT = 0x01; // 本 tick 生成了新食物 (后面跟着食物的格子)
+constexpr uint8_t NET_FINISHED = 0x02;   // 本 tick 这一局结束
+constexpr uint8_t NET_BOARD_FULL = 0x04; // 没有空闲格子了, 食物不再出现
+
+// 一个 tick 的变化
+struct NetDelta
+{
+    uint32_t tick;                // 推进之后的 Ticks()
+    uint8_t flags;                // NET_FOOD_EVENT | NET_FINISHED | NET_BOARD_FULL
+    uint8_t players[MAX_PLAYERS]; // 每条蛇: 方向 | NET_TAIL_MOVED | NET_DIED | NET_ATE_FOOD
+    Cell food;                    // NET_FOOD_EVENT 时新食物的格子
+};
+
+// 一个房间的完整状态
+struct NetKeyframe
+{
+    struct Player
+    {
+        bool alive;
+        SnakeDirection direction;
+        int32_t score;
+        std::vector<Cell> body; // 从蛇头到蛇尾; 解码时复用容量, 稳定之后不再分配
+    };
+
+    uint32_t room;
+    uint16_t round;
+    uint32_t tick;
+    SimStatus status;
+    int winner;
+    int playerCount;
+    Food food;
+    Player players[MAX_PLAYERS];
+    std::vector<uint64_t> cells; // 解码时标记已经出现过的格子 (蛇身不能交叉或重叠), 复用容量
+};
+
+// ------------------------------------------------------------------------------------
+// Encoding
+// 写入固定大小的缓冲区, 返回写入的字节数; 放不下时返回 0
+// ------------------------------------------------------------------------------------
+size_t WriteJoin(uint8_t *out, size_t capacity, uint32_t room);
+size_t WriteInput(uint8_t *out, size_t capacity, uint32_t tick, SnakeDirection direction);
+size_t WriteLeave(uint8_t *out, size_t capacity);
+size_t WriteWelcome(uint8_t *out, size_t capacity, uint32_t room, int player, int playerCount);
+size_t WriteRoomFull(uint8_t *out, size_t capacity, uint32_t room);
+size_t WriteDeltas(uint8_t *out, size_t capacity, uint32_t room, uint16_t round, int playerCount,
+                   const NetDelta *deltas, int count);
+
+template <class Board>
+size_t WriteKeyframe(uint8_t *out, size_t capacity, uint32_t room, uint16_t round,
+                     const BasicMultiSimulation<Board> &sim);
+
+// 一个 tick 之后的 delta
+template <class Board>
+NetDelta MakeDelta(const BasicMultiSimulation<Board> &sim, const MultiStepResult &step,
+                   const SnakeDirection *applied);
+
+// ------------------------------------------------------------------------------------
+// Decoding
+// 格式不对 (长度不够, 版本不同, 坐标越界, 关键帧里的蛇身交叉或重叠) 时返回 false
+// ------------------------------------------------------------------------------------
+bool ReadJoin(const uint8_t *data, size_t size, uint8_t &version, uint32_t &room);
+bool ReadInput(const uint8_t *data, size_t size, uint32_t &tick, SnakeDirection &direction);
+bool ReadWelcome(const uint8_t *data, size_t size, uint32_t &room, int &player, int &playerCount);
+bool ReadRoomFull(const uint8_t *data, size_t size, uint32_t &room);
+bool ReadKeyframe(const uint8_t *data, size_t size, int width, int height, NetKeyframe &keyframe);
+bool ReadDeltas(const uint8_t *data, size_t size, int width, int height, uint32_t &room, uint16_t &round,
+                int &playerCount, NetDelta *deltas, int &count); // deltas 至少有 NET_DELTA_REDUNDANCY 个元素
+
+// 数据报的类型, 空数据报为 0
+inline int MessageType(const uint8_t *data, size_t size) { return size > 0 ? data[0] : 0; }
+
+// round 是 16 位的回绕计数, 比较时看差值的符号
+inline bool RoundNewer(uint16_t a, uint16_t b) { return (int16_t)(uint16_t)(a - b) > 0; }
+
+// ------------------------------------------------------------------------------------
+// NetWriter / NetReader: 固定缓冲区上的小端读写, 越界后只记录失败, 不会写出或读出界
+// ------------------------------------------------------------------------------------
+class NetWriter
+{
+public:
+    NetWriter(uint8_t *out, size_t outCapacity) : data(out), capacity(outCapacity), size(0), ok(true) {}
+
+    void U8(uint32_t value) { Put(value, 1); }
+    void U16(uint32_t value) { Put(value, 2); }
+    void U32(uint32_t value) { Put(value, 4); }
+    void I16(int value) { Put((uint32_t)(uint16_t)(int16_t)value, 2); }
+    void I32(int32_t value) { Put((uint32_t)value, 4); }
+
+    uint8_t *Reserve(size_t count); // 预留 count 个字节由调用方填写, 放不下时返回 nullptr
+    size_t Finish(void) const { return ok ? size : 0; }
+
+private:
+    void Put(uint32_t value, int bytes);
+
+    uint8_t *data;
+    size_t capacity;
+    size_t size;
+    bool ok;
+};
+
+class NetReader
+{
+public:
+    NetReader(const uint8_t *in, size_t inSize) : data(in), size(inSize), offset(0), ok(true) {}
+
+    uint32_t U8(void) { return Get(1); }
+    uint32_t U16(void) { return Get(2); }
+    uint32_t U32(void) { return Get(4); }
+    int I16(void) { return (int16_t)(uint16_t)Get(2); }
+    int32_t I32(void) { return (int32_t)Get(4); }
+
+    const uint8_t *Skip(size_t count); // 跳过 count 个字节, 返回它们的起点; 不够时返回 nullptr
+    bool Ok(void) const { return ok; }
+    bool AtEnd(void) const { return ok && offset == size; }
+
+private:
+    uint32_t Get(int bytes);
+
+    const uint8_t *data;
+    size_t size;
+    size_t offset;
+    bool ok;
+};
+
+template <class Board>
+size_t WriteKeyframe(uint8_t *out, size_t capacity, uint32_t room, uint16_t round,
+                     const BasicMultiSimulation<Board> &sim)
+{
+    NetWriter writer(out, capacity);
+    writer.U8(NET_KEYFRAME);
+    writer.U32(room);
+    writer.U16(round);
+    writer.U32((uint32_t)sim.Ticks());
+    writer.U8((uint32_t)sim.Status());
+    writer.U8((uint32_t)(uint8_t)(int8_t)sim.Winner());
+    writer.U8((uint32_t)sim.PlayerCount());
+
+    const Food &food = sim.GetFood();
+    writer.I16(food.position.x);
+    writer.I16(food.position.y);
+    writer.U8(food.active ? 1 : 0);
+
+    for (int p = 0; p < sim.PlayerCount(); p++)
+    {
+        const auto &snake = sim.GetSnake(p);
+        const bool alive = sim.Alive(p);
+        const size_t length = alive ? snake.Size() : 0; // 死掉的蛇已经不在棋盘上
+        writer.U8(alive ? 1 : 0);
+        writer.U8((uint32_t)sim.Direction(p));
+        writer.I32(sim.Score(p));
+        writer.U16((uint32_t)length);
+        if (length == 0)
+        {
+            writer.I16(0);
+            writer.I16(0);
+            continue;
+        }
+
+        const Cell head = snake.Head().position;
+        writer.I16(head.x);
+        writer.I16(head.y);
+
+        // 之后每一节只记录它相对前一节的方向
+        uint8_t *packed = writer.Reserve((length - 1 + 3) / 4);
+        if (packed == nullptr)
+            return 0;
+        for (size_t i = 1; i < length; i++)
+        {
+            Cell previous = snake[i - 1].position;
+            Cell current = snake[i].position;
+            SnakeDirection dir = (current.x > previous.x)   ? DIR_RIGHT
+                                 : (current.x < previous.x) ? DIR_LEFT
+                                 : (current.y < previous.y) ? DIR_UP
+                                                            : DIR_DOWN;
+            size_t bit = (i - 1) * 2;
+            if (bit % 8 == 0)
+                packed[bit / 8] = 0;
+            packed[bit / 8] |= (uint8_t)(dir << (bit % 8));
+        }
+    }
+    return writer.Finish();
+}
+
+template <class Board>
+NetDelta MakeDelta(const BasicMultiSimulation<Board> &sim, const MultiStepResult &step,
+                   const SnakeDirection *applied)
+{
+    NetDelta delta = {};
+    delta.tick = (uint32_t)sim.Ticks();
+    bool ate = false;
+    for (int p = 0; p < sim.PlayerCount(); p++)
+    {
+        const StepResult &result = step.players[p];
+        uint8_t value = (uint8_t)(applied[p] & NET_DIRECTION_MASK);
+        if (result.tailMoved)
+            value |= NET_TAIL_MOVED;
+        if (result.died)
+            value |= NET_DIED;
+        if (result.ateFood)
+        {
+            value |= NET_ATE_FOOD;
+            ate = true;
+        }
+        delta.players[p] = value;
+    }
+
+    const Food &food = sim.GetFood();
+    if (ate && food.active)
+    {
+        delta.flags |= NET_FOOD_EVENT;
+        delta.food = food.position;
+    }
+    if (ate && !food.active)
+        delta.flags |= NET_BOARD_FULL;
+    if (!sim.Running())
+        delta.flags |= NET_FINISHED;
+    return delta;
+}
+
+// ------------------------------------------------------------------------------------
+// NetReplica: 客户端上的服务器状态副本
+// 从关键帧重建, 之后逐个 tick 应用 delta; 每个 delta 都和自己推进的结果比较,
+// 不一致 (或者中间缺了 tick) 时标记为不同步, 等下一个关键帧
+// ------------------------------------------------------------------------------------
+typedef enum
+{
+    NET_APPLIED = 0, // 推进了一个 tick
+    NET_STALE,       // 已经应用过 (重复携带的 delta)
+    NET_GAP,         // 中间缺了 tick, 或者还没有收到关键帧
+    NET_DESYNC       // 推进的结果和服务器不一致
+} NetApplyResult;
+
+template <class Board>
+class BasicNetReplica
+{
+public:
+    BasicNetReplica(void) : board(), sim(), round(0), synced(false) {}
+
+    // 新的一局, 或者同一局里不比副本旧的关键帧才会被采用
+    bool ApplyKeyframe(const Board &newBoard, const NetKeyframe &keyframe);
+    NetApplyResult ApplyDelta(uint16_t deltaRound, const NetDelta &delta);
+
+    bool Synced(void) const { return synced; }
+    uint16_t Round(void) const { return round; }
+    const BasicMultiSimulation<Board> &GetSimulation(void) const { return sim; }
+
+    void Invalidate(void) { synced = false; } // 丢弃副本, 等下一个关键帧 (例如重新加入房间)
+
+private:
+    Board board;
+    BasicMultiSimulation<Board> sim;
+    uint16_t round;
+    bool synced;
+};
+
+template <class Board>
+bool BasicNetReplica<Board>::ApplyKeyframe(const Board &newBoard, const NetKeyframe &keyframe)
+{
+    if (synced && keyframe.round == round && keyframe.tick < sim.Ticks())
+        return false; // 乱序到达的旧关键帧
+    if (synced && RoundNewer(round, keyframe.round))
+        return false; // 上一局的关键帧
+
+    board = newBoard;
+    round = keyframe.round;
+    sim.Restore(board, keyframe.playerCount, keyframe.tick, keyframe.status, keyframe.winner);
+    for (int p = 0; p < keyframe.playerCount; p++)
+    {
+        const NetKeyframe::Player &player = keyframe.players[p];
+        sim.RestoreSnake(p, player.body.data(), (int)player.body.size(), player.direction, player.score, player.alive);
+    }
+    sim.PlaceFood(keyframe.food);
+    synced = true;
+    return true;
+}
+
+template <class Board>
+NetApplyResult BasicNetReplica<Board>::ApplyDelta(uint16_t deltaRound, const NetDelta &delta)
+{
+    if (synced && RoundNewer(round, deltaRound))
+        return NET_STALE;
+    if (!synced || deltaRound != round)
+        return NET_GAP;
+    if (delta.tick <= sim.Ticks())
+        return NET_STALE;
+    if (delta.tick != sim.Ticks() + 1 || !sim.Running())
+    {
+        synced = false;
+        return NET_GAP;
+    }
+
+    SnakeDirection inputs[MAX_PLAYERS];
+    for (int p = 0; p < sim.PlayerCount(); p++)
+    {
+        inputs[p] = (SnakeDirection)(delta.players[p] & NET_DIRECTION_MASK);
+    }
+    MultiStepResult step = sim.Step(inputs);
+    if (delta.flags & NET_FOOD_EVENT)
+        sim.PlaceFood({delta.food, true});
+    else if (delta.flags & NET_BOARD_FULL)
+        sim.PlaceFood(Food{});
+
+    // 自己推进出来的事件必须和服务器一致, 否则之后的每个 tick 都不可信
+    for (int p = 0; p < sim.PlayerCount(); p++)
+    {
+        const StepResult &result = step.players[p];
+        uint8_t events = (uint8_t)((result.tailMoved ? NET_TAIL_MOVED : 0) | (result.died ? NET_DIED : 0) |
+                                   (result.ateFood ? NET_ATE_FOOD : 0));
+        if (events != (delta.players[p] & (NET_TAIL_MOVED | NET_DIED | NET_ATE_FOOD)))
+        {
+            synced = false;
+            return NET_DESYNC;
+        }
+    }
+    if (((delta.flags & NET_FINISHED) != 0) == sim.Running())
+    {
+        synced = false;
+        return NET_DESYNC;
+    }
+    return NET_APPLIED;
+}
+
+// 常用的棋盘在 NetProtocol.cpp 里显式实例化
+extern template class BasicNetReplica<DynamicBoard>;
+extern template class BasicNetReplica<ClassicBoard>;
+
+typedef BasicNetReplica<ClassicBoard> ClassicNetReplica; // 服务器的房间都是 40x30 棋盘
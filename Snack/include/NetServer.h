@@ -0,0 +1,158 @@
+#pragma once
+
+#include "MultiSimulation.h"
+#include "NetProtocol.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unordered_map>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// NetServer: 无窗口的权威服务器 (只支持 Linux: 非阻塞 UDP + epoll + recvmmsg / sendmmsg)
+// - 一个 socket 服务所有房间, 客户端按地址识别; 每个房间是一局 40x30 的 MultiSimulation
+// - 固定 tick (整数微秒的截止时间, 不会漂移): 所有进行中的房间在线程池上按块并行推进,
+//   每个房间把本 tick 的数据报编码进自己的缓冲区 (同一个房间的玩家收到的字节完全相同),
+//   然后主线程用 sendmmsg 成批发出, 一次系统调用发几百个数据报
+// - 两个 tick 之间 epoll_wait 等待输入, 可读时用 recvmmsg 一次收一批
+// - 房间和客户端的存储在 Open 时按上限一次分配, 运行中不再分配 (地址表除外)
+// - 房间坐满后开局; 一局结束后停 ROUND_RESTART_TICKS 个 tick, 人还齐就开下一局
+// ------------------------------------------------------------------------------------
+
+struct NetServerConfig
+{
+    uint16_t port;
+    int roomCount;      // 房间数上限
+    int playersPerRoom; // 每个房间几个人开局 (1..MAX_PLAYERS)
+    uint32_t tickMicros;
+    int threads;        // 推进房间的线程数, 0 = 全部硬件线程
+    uint32_t seed;      // 房间 r 第 k 局的种子是 (seed << 32 | k), 流是 r
+    bool verbose;       // 每 5 秒打印一次统计
+};
+
+struct NetServerStats
+{
+    uint64_t ticks;
+    uint64_t roomTicks;     // 所有房间推进的 tick 总数
+    uint64_t packetsIn;
+    uint64_t packetsOut;
+    uint64_t bytesOut;
+    uint64_t sendDropped;   // 发送缓冲区满时丢弃的数据报 (UDP 尽力而为, 靠冗余和关键帧恢复)
+    uint64_t badPackets;
+    int clients;
+    int playingRooms;
+};
+
+class NetServer
+{
+public:
+    NetServer(void);
+    ~NetServer(void);
+
+    NetServer(const NetServer &) = delete;
+    NetServer &operator=(const NetServer &) = delete;
+
+    bool Open(const NetServerConfig &config); // 绑定端口并分配所有房间; 失败时打印原因并返回 false
+    void Close(void);
+
+    void Run(const std::atomic<bool> &stop); // 跑到 stop 被置位
+
+    uint16_t Port(void) const { return boundPort; } // 实际绑定的端口 (配置为 0 时由系统分配)
+    const NetServerStats &Stats(void) const { return stats; }
+
+private:
+    static const int RECV_BATCH = 64;                 // 一次 recvmmsg 最多收的数据报数
+    static const int SEND_BATCH = 256;                // 一次 sendmmsg 最多发的数据报数
+    static const uint32_t ROUND_RESTART_TICKS = 20;   // 一局结束后到下一局开始的 tick 数
+    static const int64_t CLIENT_TIMEOUT_MICROS = 5000000;
+
+    typedef enum
+    {
+        ROOM_WAITING = 0, // 等人
+        ROOM_PLAYING,
+        ROOM_FINISHED     // 一局刚结束, 倒计时后开下一局
+    } RoomState;
+
+    struct ScheduledInput
+    {
+        uint32_t tick; // 生效的 tick, 0 = 空
+        SnakeDirection direction;
+    };
+
+    struct alignas(64) Room
+    {
+        ClassicMultiSimulation sim;
+        int clients[MAX_PLAYERS];            // 每个座位上的客户端, 空座位为 -1
+        SnakeDirection inputs[MAX_PLAYERS];  // 每个座位当前生效的方向
+        ScheduledInput scheduled[MAX_PLAYERS][NET_INPUT_WINDOW]; // 按 tick 排队的输入, 下标是 tick % 窗口
+        NetDelta history[NET_DELTA_REDUNDANCY]; // 最近的 delta, 最新的在最后
+        int historyCount;
+        RoomState state;
+        int seated;
+        uint16_t round;
+        uint32_t countdown;
+        uint32_t sinceKeyframe;
+        bool keyframeDue;
+        size_t deltaSize;                    // 本 tick 要发的数据报 (0 = 不发)
+        size_t keyframeSize;
+        uint8_t deltaPacket[NET_MAX_DATAGRAM];
+        uint8_t keyframePacket[NET_MAX_DATAGRAM];
+    };
+
+    struct Client
+    {
+        uint64_t key;        // 地址 (IPv4 << 16 | 端口)
+        sockaddr_in address;
+        int room;            // 空闲的客户端槽为 -1
+        int seat;
+        int64_t lastHeard;   // 微秒
+    };
+
+    static int64_t NowMicros(void);
+
+    void ReceiveAll(int64_t now);
+    void HandleDatagram(const sockaddr_in &address, const uint8_t *data, size_t size, int64_t now);
+    void HandleJoin(const sockaddr_in &address, uint64_t key, uint32_t room, int64_t now);
+    void HandleInput(Room &room, int seat, uint32_t tick, SnakeDirection direction);
+    void RemoveClient(int client);
+    void DropSilentClients(int64_t now);
+
+    int FindOpenRoom(void);
+    void StartRound(int room);
+    void StepRoom(int room);
+    void Tick(void);
+    void SendTick(void);
+    void Queue(const Client &client, const uint8_t *data, size_t size); // Add one datagram to the send batch
+    void Flush(void); // Send the batch with as few sendmmsg calls as possible
+    void SendNow(const sockaddr_in &address, const uint8_t *data, size_t size);
+
+    NetServerConfig config;
+    int socketFd;
+    int epollFd;
+    uint16_t boundPort;
+    std::unique_ptr<ThreadPool> pool;
+
+    std::vector<Room> rooms;
+    std::vector<int> activeRooms;  // 有人的房间, 每个 tick 只看这些
+    std::vector<int> activeSlot;   // 房间在 activeRooms 里的位置, 不在时为 -1
+    int openRoomHint;              // FindOpenRoom 从这里开始找
+
+    std::vector<Client> clients;
+    std::vector<int> freeClients;
+    std::unordered_map<uint64_t, int> clientByAddress;
+
+    // 成批收发的缓冲区 (Open 时分配); 发送的 iovec 直接指向房间里的数据报, 不复制
+    std::vector<uint8_t> recvBuffers;
+    std::vector<mmsghdr> recvHeaders;
+    std::vector<iovec> recvVectors;
+    std::vector<sockaddr_in> recvAddresses;
+    std::vector<mmsghdr> sendHeaders;
+    std::vector<iovec> sendVectors;
+    std::vector<sockaddr_in> sendAddresses;
+    int sendCount;
+
+    NetServerStats stats;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "NetProtocol.h"
+#include "Prediction.h"
+#include <cstddef>
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// NetSession: 联网客户端的协议状态机, 不碰 socket (游戏用 UdpClient 收发, NetBots 用自己的 epoll)
+// - Receive 处理服务器发来的每个数据报: 关键帧和 delta 维护权威副本 (NetReplica),
+//   副本每推进一次就和预测对账 (Predictor), 不一致时回滚重算
+// - Tick 每个本地 tick 调用一次: 预测立刻用本地输入推进, 然后写出要发的 INPUT,
+//   上面标着这个输入在服务器上应该生效的 tick
+// - 预测要领先服务器大约一个往返, 输入才能按时到达; 领先量从 MIN_LEAD 开始,
+//   本地输入晚到 (服务器上的方向和预测不一致) 时加一, 连续 LEAD_DECAY_TICKS 个 tick 都按时就减一
+// ------------------------------------------------------------------------------------
+class NetSession
+{
+public:
+    static const int MIN_LEAD = 2;
+    static const int MAX_LEAD = ClassicPredictor::HISTORY / 2;
+    static const int LEAD_DECAY_TICKS = 256;
+    static const int REJOIN_TICKS = 16; // 不同步时每隔这么多个 tick 重发 JOIN 请求关键帧
+
+    NetSession(void);
+
+    void Reset(uint32_t room = NET_ANY_ROOM); // 重新开始加入 (room 为 NET_ANY_ROOM 时由服务器分配)
+
+    void Receive(const uint8_t *data, size_t size);
+
+    // 推进预测并写出这个 tick 要发的数据报 (还没进房间时是 JOIN), 返回字节数
+    size_t Tick(SnakeDirection localInput, uint8_t *out, size_t capacity);
+
+    size_t WriteGoodbye(uint8_t *out, size_t capacity) const { return WriteLeave(out, capacity); }
+
+    bool Welcomed(void) const { return welcomed; }
+    bool RoomFull(void) const { return roomFull; }
+    bool Playing(void) const { return predicting; } // 收到过这一局的关键帧, 预测状态可以显示
+    uint32_t Room(void) const { return room; }
+    int LocalPlayer(void) const { return player; }
+    int InputLead(void) const { return inputLead; }
+
+    const ClassicMultiSimulation &GetSimulation(void) const { return predictor.GetSimulation(); } // 预测状态
+    const ClassicMultiSimulation &GetAuthoritative(void) const { return replica.GetSimulation(); }
+    const ClassicPredictor &GetPredictor(void) const { return predictor; }
+    const MultiStepResult &LastStep(void) const { return lastStep; } // 最近一次预测推进的事件, 用于插值绘制
+
+    uint64_t Desyncs(void) const { return desyncs; }
+    uint64_t Gaps(void) const { return gaps; }
+
+private:
+    void Reconcile(void);
+
+    ClassicNetReplica replica;
+    ClassicPredictor predictor;
+    NetKeyframe keyframe; // 解码关键帧的暂存 (蛇身的 vector 保留容量)
+    MultiStepResult lastStep;
+
+    uint32_t requestedRoom;
+    uint32_t room;
+    int player;
+    bool welcomed;
+    bool roomFull;
+    bool predicting;
+    uint16_t predictedRound;
+
+    int inputLead;
+    int onTimeTicks;
+    uint64_t seenMispredictions;
+    int sinceRejoin;
+
+    uint64_t desyncs;
+    uint64_t gaps;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "NetSession.h"
+#include "Screen.h"
+#include "Speed.h"
+#include "SpscQueue.h"
+#include "TextCache.h"
+#include "UdpClient.h"
+#include "ViewportRenderer.h"
+
+// ------------------------------------------------------------------------------------
+// OnlineScreen: 连到权威服务器 (tools/Server) 的联网对战
+// 服务器地址来自环境变量 SNAKE_SERVER ("host" 或 "host:port"), 默认 127.0.0.1:7777
+// 本地的转向不等服务器: NetSession 每个 tick 立刻推进预测状态并画出来,
+// 服务器的状态和预测不一致时回滚重算, 画面上只会看到对手偶尔被纠正一两格
+// 方向键和 WASD 都能控制; 一局结束后服务器自动开下一局, ESC 离开房间回到菜单
+// ------------------------------------------------------------------------------------
+class OnlineScreen : public Screen
+{
+public:
+    OnlineScreen(void);
+
+    void Load(void) override;
+    void Unload(void) override;
+    void Enter(Game &game) override;
+    void Exit(Game &game) override;
+    void Update(Game &game, float frameTime) override;
+    void Draw(const Game &game) override;
+
+private:
+    static const uint16_t DEFAULT_PORT = 7777;
+
+    void Connect(void);                 // Open the socket to SNAKE_SERVER and start joining
+    void ReceiveAll(void);              // Feed every pending datagram to the session
+    void HandleInput(void);             // Buffer this frame's turns for the local snake
+    void QueueTurn(SnakeDirection dir); // Buffer one turn, dropping no-ops and reversals
+    void StepGame(void);                // Predict one tick and send the stamped input
+
+    UdpClient socket;
+    NetSession session;
+    ViewportRenderer renderer;
+    SpscQueue<SnakeDirection, 4> pendingTurns; // 还没应用的转向
+    SnakeDirection lastQueuedDir;
+    TickClock clock; // 固定步长累加器 (整数微秒, 和服务器的 tick 一样长)
+    float alpha;     // 到下一个 tick 的进度, 用于插值绘制
+    bool connected;  // socket 打开成功 (地址能解析)
+
+    CachedNumberText scoreTexts[MAX_PLAYERS];
+    CachedNumberText winnerText;
+    StaticLabel connectingLabel;
+    StaticLabel waitingLabel;
+    StaticLabel roomFullLabel;
+    StaticLabel drawLabel;
+    StaticLabel noServerLabel;
+};
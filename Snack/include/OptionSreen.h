@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Screen.h"
+#include "Speed.h"
+#include "TextCache.h"
+
+struct GameOptions;
+
+// ------------------------------------------------------------------------------------
+// OptionScreen: 选项画面, 叠在主菜单之上打开, 关闭后回到主菜单
+// 左右键切换音效, 棋盘大小和速度曲线, 新的棋盘大小和速度在下一局开始时生效
+// ------------------------------------------------------------------------------------
+class OptionScreen : public Screen
+{
+public:
+    OptionScreen(void);
+
+    void Load(void) override;
+    void Unload(void) override;
+    void Enter(Game &game) override;
+    void Update(Game &game, float frameTime) override;
+    void Draw(const Game &game) override;
+
+private:
+    enum
+    {
+        ITEM_SOUND = 0,
+        ITEM_BOARD,
+        ITEM_SPEED,
+        ITEM_BACK,
+        ITEM_COUNT
+    };
+
+    static const int BOARD_PRESET_COUNT = 5;
+
+    static int FindBoardPreset(const GameOptions &options);
+
+    StaticLabel titleLabel;
+    StaticLabel soundOnLabel;
+    StaticLabel soundOffLabel;
+    StaticLabel boardLabels[BOARD_PRESET_COUNT]; // 每个棋盘大小一张预先光栅化的文字
+    StaticLabel speedLabels[SPEED_CURVE_COUNT];
+    StaticLabel backLabel;
+    int selected;
+};
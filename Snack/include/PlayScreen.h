@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Autopilot.h"
+#include "BoardRenderer.h"
+#include "Replay.h"
+#include "Screen.h"
+#include "Simulation.h"
+#include "Speed.h"
+#include "SpscQueue.h"
+#include "StatsStore.h"
+#include "TextCache.h"
+#include "ViewportRenderer.h"
+
+// ------------------------------------------------------------------------------------
+// PlayScreen: 游戏进行中的画面
+// 负责输入, 固定步长模拟, 音效和绘制; 游戏逻辑本身在 Simulation 里
+// 重新开始 (InitGame) 只是重置状态, 不分配内存也不重建资源
+// HUD 的分数只在变化时重新格式化, "PAUSED" 预先光栅化
+// 每局都会录像 (种子 + 转向事件), 结束时保存, 用于复现和审计
+// 每局的战绩交给 Game 的 StatsStore, 写盘在它的后台线程上
+// 棋盘大小来自选项: 默认的 40x30 跑编译期棋盘的 ClassicSimulation, 用增量绘制的 BoardRenderer;
+// 其它大小跑 DynamicBoard, 用跟随蛇头的 ViewportRenderer, 只画可见的格子
+// A 键打开 / 关闭自动驾驶, 它的决定和按键一样进入转向队列
+// tick 间隔按选项里的速度曲线随吃到的食物缩短, 只在吃到食物时重新计算
+// ------------------------------------------------------------------------------------
+class PlayScreen : public Screen
+{
+public:
+    PlayScreen(void);
+
+    void Load(void) override;
+    void Unload(void) override;
+    void Enter(Game &game) override;
+    void Update(Game &game, float frameTime) override;
+    void Draw(const Game &game) override;
+
+private:
+    void InitGame(void);                // Reset the round, keeping all allocations
+    void ResetAutopilot(void);          // Prepare the autopilot for the current board
+    void HandleInput(void);             // Drain this frame's key presses into the turn queue
+    void QueueTurn(SnakeDirection dir); // Buffer one turn, dropping no-ops and reversals
+
+    // 两种棋盘共用的逻辑, 按 useViewport 选择 classicSim 或 sim
+    template <class Board>
+    void BeginRound(BasicSimulation<Board> &round, const Board &roundBoard, uint64_t seed);
+    template <class Board>
+    bool RunTicks(Game &game, BasicSimulation<Board> &round, BasicAutopilot<Board> &pilot); // 这一局结束时返回 true
+    template <class Board>
+    void StepGame(BasicSimulation<Board> &round); // Advance the simulation by one fixed tick
+    template <class Board>
+    GameRecord MakeRecord(const BasicSimulation<Board> &round) const; // Summarize the finished round for the stats log
+
+    DynamicBoard board;                        // 本局的棋盘大小 (进入画面时从选项读取)
+    bool useViewport;                          // 不是默认大小: 跑 sim, 用视口绘制
+    ClassicSimulation classicSim;              // 默认 40x30 的游戏逻辑 (编译期棋盘, 下标运算都是常量)
+    Simulation sim;                            // 其它大小的游戏逻辑
+    BoardRenderer boardRenderer;               // 网格和蛇身的增量绘制 (一屏正好放下的棋盘)
+    ViewportRenderer viewportRenderer;         // 跟随蛇头的视口 (更大的棋盘)
+    SpscQueue<SnakeDirection, 4> pendingTurns; // 还没应用的转向, 每个 tick 取一个, 快速连按不会丢
+    SnakeDirection lastQueuedDir;              // 最后排队的方向, 用于防止 180 度转向
+    TickClock clock;                           // 固定步长累加器 (整数微秒)
+    SpeedCurve speed;                          // 选项里的速度曲线, 进入画面时读取
+    uint32_t foodEaten;                        // 这一局吃到的食物数, 决定当前的 tick 间隔
+    float alpha;                               // 到下一个 tick 的进度, 用于插值绘制
+    StepResult lastStep;                       // 上一个 tick 的事件, 用于插值绘制
+    bool paused;
+    ReplayRecorder recorder;                   // 本局的录像, 结束时写到文件
+    ClassicAutopilot classicAutopilot;         // 自动驾驶 (沿回路抄近路), 和 classicSim 配套
+    Autopilot autopilot;                       // 和 sim 配套, 搜索数组只在打开时分配
+    bool autopilotEnabled;
+    bool autopilotUsed;                        // 这一局自动驾驶开过 (战绩不进排行榜)
+    double playTime;                           // 这一局实际游玩的秒数, 不含暂停
+
+    CachedNumberText scoreText;
+    StaticLabel pausedLabel;
+    StaticLabel autopilotLabel;
+};
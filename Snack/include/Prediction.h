@@ -0,0 +1,183 @@
+#pragma once
+
+#include "MultiSimulation.h"
+#include <cstdint>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// Predictor: 联网对战的客户端预测和回滚
+// - 本地的转向不等服务器确认, 每个本地 tick 立刻推进预测状态: 本地玩家用自己的输入,
+//   其他玩家沿用权威状态里的最新方向
+// - 每个预测出来的 tick 都把完整状态 (可以 memcpy 的 MultiSimulation) 和当时的本地输入
+//   存进一个 HISTORY 大小的环形缓冲区, 缓冲区只在第一次 Reset 时分配
+// - 权威状态推进到 tick T 时和环里第 T 个预测比较; 不一致 (对手转向, 食物位置,
+//   本地输入晚到了服务器) 就把预测状态换成权威状态, 再用记录的本地输入重新推进到现在
+// - 比较的是看得见的状态 (蛇头, 蛇尾, 长度, 方向, 分数, 食物), 不比较随机数和空闲格子索引:
+//   客户端的食物总是采用服务器的位置 (见 NetReplica)
+// ------------------------------------------------------------------------------------
+template <class Board>
+class BasicPredictor
+{
+public:
+    static const int HISTORY = 32; // 环形缓冲区的大小, 预测最多领先权威状态 HISTORY - 1 个 tick
+
+    BasicPredictor(void) : predicted(), frames(), authoritativeTick(0), localPlayer(0), otherInputs(), rollbacks(0),
+                           resimulatedTicks(0), localMispredictions(0) {}
+
+    // 从权威状态重新开始预测 (收到关键帧之后)
+    void Reset(const BasicMultiSimulation<Board> &authoritative, int newLocalPlayer);
+
+    // 立刻推进一个 tick; 已经领先 HISTORY - 1 个 tick 或者这一局已经结束时不推进, 返回 false
+    bool Advance(SnakeDirection localInput, MultiStepResult *result = nullptr);
+
+    // 权威状态推进到了新的 tick (NetReplica 应用了 delta 之后调用); 发生回滚时返回 true
+    bool Reconcile(const BasicMultiSimulation<Board> &authoritative);
+
+    const BasicMultiSimulation<Board> &GetSimulation(void) const { return predicted; }
+    int LocalPlayer(void) const { return localPlayer; }
+    int Lead(void) const { return (int)(predicted.Ticks() - authoritativeTick); } // 领先权威状态的 tick 数
+
+    uint64_t Rollbacks(void) const { return rollbacks; }
+    uint64_t ResimulatedTicks(void) const { return resimulatedTicks; }
+    uint64_t LocalMispredictions(void) const { return localMispredictions; } // 本地输入没有按预测的 tick 生效
+
+private:
+    struct Frame
+    {
+        BasicMultiSimulation<Board> state; // 第 tick 个 tick 之后的预测状态
+        SnakeDirection localInput;         // 从上一个 tick 推进到这个 tick 时的本地输入
+    };
+
+    Frame &At(uint64_t tick) { return frames[(size_t)(tick % HISTORY)]; }
+    MultiStepResult StepPredicted(SnakeDirection localInput);
+    static bool SameVisibleState(const BasicMultiSimulation<Board> &a, const BasicMultiSimulation<Board> &b);
+
+    BasicMultiSimulation<Board> predicted;
+    std::vector<Frame> frames;
+    uint64_t authoritativeTick;
+    int localPlayer;
+    SnakeDirection otherInputs[MAX_PLAYERS]; // 权威状态里每个玩家的最新方向
+
+    uint64_t rollbacks;
+    uint64_t resimulatedTicks;
+    uint64_t localMispredictions;
+};
+
+template <class Board>
+void BasicPredictor<Board>::Reset(const BasicMultiSimulation<Board> &authoritative, int newLocalPlayer)
+{
+    if (frames.empty())
+        frames.resize(HISTORY);
+
+    localPlayer = newLocalPlayer;
+    authoritativeTick = authoritative.Ticks();
+    for (int p = 0; p < authoritative.PlayerCount(); p++)
+    {
+        otherInputs[p] = authoritative.Direction(p);
+    }
+    CopyState(predicted, authoritative);
+    CopyState(At(authoritativeTick).state, predicted);
+    At(authoritativeTick).localInput = predicted.Direction(localPlayer);
+}
+
+template <class Board>
+MultiStepResult BasicPredictor<Board>::StepPredicted(SnakeDirection localInput)
+{
+    SnakeDirection inputs[MAX_PLAYERS];
+    for (int p = 0; p < predicted.PlayerCount(); p++)
+    {
+        inputs[p] = (p == localPlayer) ? localInput : otherInputs[p];
+    }
+    MultiStepResult result = predicted.Step(inputs);
+
+    Frame &frame = At(predicted.Ticks());
+    CopyState(frame.state, predicted);
+    frame.localInput = localInput;
+    return result;
+}
+
+template <class Board>
+bool BasicPredictor<Board>::Advance(SnakeDirection localInput, MultiStepResult *result)
+{
+    if (frames.empty() || !predicted.Running() || Lead() >= HISTORY - 1)
+        return false;
+
+    MultiStepResult step = StepPredicted(localInput);
+    if (result != nullptr)
+        *result = step;
+    return true;
+}
+
+template <class Board>
+bool BasicPredictor<Board>::Reconcile(const BasicMultiSimulation<Board> &authoritative)
+{
+    if (frames.empty())
+        return false;
+
+    const uint64_t tick = authoritative.Ticks();
+    for (int p = 0; p < authoritative.PlayerCount(); p++)
+    {
+        otherInputs[p] = authoritative.Direction(p);
+    }
+    authoritativeTick = tick;
+
+    // 服务器已经走到预测前面了 (本地卡顿): 直接采用权威状态
+    if (tick >= predicted.Ticks())
+    {
+        bool mismatch = tick > predicted.Ticks() || !SameVisibleState(predicted, authoritative);
+        CopyState(predicted, authoritative);
+        CopyState(At(tick).state, predicted);
+        At(tick).localInput = predicted.Direction(localPlayer);
+        return mismatch;
+    }
+
+    const Frame &frame = At(tick);
+    if (SameVisibleState(frame.state, authoritative))
+        return false;
+
+    if (frame.state.Direction(localPlayer) != authoritative.Direction(localPlayer))
+        localMispredictions++;
+
+    // 回滚: 从权威状态出发, 用记录的本地输入重新推进到当前的预测 tick
+    const uint64_t target = predicted.Ticks();
+    CopyState(predicted, authoritative);
+    CopyState(At(tick).state, predicted);
+    for (uint64_t t = tick + 1; t <= target && predicted.Running(); t++)
+    {
+        StepPredicted(At(t).localInput);
+        resimulatedTicks++;
+    }
+    rollbacks++;
+    return true;
+}
+
+template <class Board>
+bool BasicPredictor<Board>::SameVisibleState(const BasicMultiSimulation<Board> &a, const BasicMultiSimulation<Board> &b)
+{
+    const Food &foodA = a.GetFood();
+    const Food &foodB = b.GetFood();
+    if (a.Status() != b.Status() || foodA.active != foodB.active || (foodA.active && foodA.position != foodB.position))
+        return false;
+
+    for (int p = 0; p < a.PlayerCount(); p++)
+    {
+        if (a.Alive(p) != b.Alive(p) || a.Direction(p) != b.Direction(p) || a.Score(p) != b.Score(p))
+            return false;
+        if (!a.Alive(p))
+            continue;
+
+        // 同一个起点出发, 每个 tick 的蛇头, 蛇尾和长度都相同, 整条身体就相同
+        const auto &snakeA = a.GetSnake(p);
+        const auto &snakeB = b.GetSnake(p);
+        if (snakeA.Size() != snakeB.Size() || snakeA.Head().position != snakeB.Head().position ||
+            snakeA.Tail().position != snakeB.Tail().position)
+            return false;
+    }
+    return true;
+}
+
+// 常用的棋盘在 Prediction.cpp 里显式实例化
+extern template class BasicPredictor<DynamicBoard>;
+extern template class BasicPredictor<ClassicBoard>;
+
+typedef BasicPredictor<ClassicBoard> ClassicPredictor; // 服务器的房间都是 40x30 棋盘
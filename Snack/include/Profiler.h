@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// Profiler: 分段计时和内存分配计数
+// 只有定义了 SNAKE_ENABLE_PROFILER 才会编译进来; 否则所有宏都展开成空语句,
+// 函数都是空的内联函数, 没有任何运行时开销
+//
+// - SNAKE_PROFILE_SCOPE(section): 统计当前作用域的耗时 (steady_clock, 纳秒)
+// - 每个分段一张对数直方图 (每个 2 倍区间 8 个桶, 误差 < 12.5%), 不保存样本,
+//   由直方图估计 p50 / p99, 同时精确记录次数, 总耗时和最大值
+// - 替换全局 operator new, 统计 C++ 的分配次数 (raylib 内部的 malloc 不在其中)
+// - 计数都是原子操作, BatchEnv 的工作线程也可以安全地记录
+// ------------------------------------------------------------------------------------
+
+typedef enum
+{
+    PROFILE_FRAME = 0,  // 一整帧 (更新 + 绘制 + 等待垂直同步)
+    PROFILE_UPDATE,     // 当前画面的 Update
+    PROFILE_STEP,       // 一个模拟 tick
+    PROFILE_SPAWN_FOOD, // 生成食物
+    PROFILE_DRAW,       // 当前画面的 Draw
+    PROFILE_COUNT
+} ProfileSection;
+
+struct ProfileSummary
+{
+    const char *name;
+    uint64_t count;
+    double totalUs;
+    double meanUs;
+    double p50Us;
+    double p99Us;
+    double maxUs;
+};
+
+// ------------------------------------------------------------------------------------
+// 直方图的桶: 小于 8 ns 的值各占一个桶, 之后每个 2 倍区间按最高的几位分成 8 个桶
+// 放在头文件里, 没有编译进 Profiler 时也可以测试
+// ------------------------------------------------------------------------------------
+constexpr int PROFILE_SUB_BUCKET_BITS = 3;
+constexpr int PROFILE_SUB_BUCKETS = 1 << PROFILE_SUB_BUCKET_BITS;
+constexpr int PROFILE_MAX_EXPONENT = 48; // 2^48 ns, 约 78 小时, 再大的值 (比如时钟跳变) 落在最后一个桶
+constexpr int PROFILE_BUCKET_COUNT = (PROFILE_MAX_EXPONENT - PROFILE_SUB_BUCKET_BITS + 1) * PROFILE_SUB_BUCKETS;
+
+inline int ProfileBucketOf(uint64_t ns)
+{
+    if (ns < (uint64_t)PROFILE_SUB_BUCKETS)
+        return (int)ns;
+
+    int exponent = 0;
+    for (uint64_t value = ns; value >>= 1;)
+        exponent++;
+    if (exponent >= PROFILE_MAX_EXPONENT)
+        return PROFILE_BUCKET_COUNT - 1;
+
+    int mantissa = (int)((ns >> (exponent - PROFILE_SUB_BUCKET_BITS)) & (PROFILE_SUB_BUCKETS - 1));
+    return (exponent - PROFILE_SUB_BUCKET_BITS + 1) * PROFILE_SUB_BUCKETS + mantissa;
+}
+
+// 桶的下界和上界 (上界不包含; 最后一个桶还收下所有不小于上界的值)
+inline void ProfileBucketBounds(int bucket, double &low, double &high)
+{
+    if (bucket < PROFILE_SUB_BUCKETS)
+    {
+        low = bucket;
+        high = bucket + 1;
+        return;
+    }
+
+    int exponent = bucket / PROFILE_SUB_BUCKETS + PROFILE_SUB_BUCKET_BITS - 1;
+    int mantissa = bucket % PROFILE_SUB_BUCKETS;
+    double unit = (double)(1ull << (exponent - PROFILE_SUB_BUCKET_BITS));
+    low = (PROFILE_SUB_BUCKETS + mantissa) * unit;
+    high = low + unit;
+}
+
+#ifdef SNAKE_ENABLE_PROFILER
+
+#include <chrono>
+
+void ProfileRecord(ProfileSection section, uint64_t nanoseconds);
+ProfileSummary GetProfileSummary(ProfileSection section);
+void ResetProfile(void);
+
+uint64_t GetAllocationCount(void);      // 程序开始以来的分配次数
+uint64_t GetFrameAllocationCount(void); // 上一帧的分配次数
+void ProfileFrameEnd(void);             // 每帧结束时调用一次
+
+bool SaveProfileCsv(const char *fileName);
+bool SaveProfileJson(const char *fileName);
+
+// 覆盖层 (ProfilerOverlay.cpp, 依赖 raylib): F3 显示 / 隐藏, F4 导出 profile.csv 和 profile.json
+void UpdateProfilerOverlay(void);
+void DrawProfilerOverlay(void);
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileSection profileSection)
+        : section(profileSection), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ProfileScope(void)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        ProfileRecord(section, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    ProfileSection section;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define SNAKE_PROFILE_CONCAT_INNER(a, b) a##b
+#define SNAKE_PROFILE_CONCAT(a, b) SNAKE_PROFILE_CONCAT_INNER(a, b)
+#define SNAKE_PROFILE_SCOPE(section) ProfileScope SNAKE_PROFILE_CONCAT(profileScope, __LINE__)(section)
+#define SNAKE_PROFILE_FRAME_END() ProfileFrameEnd()
+
+#else
+
+inline void ResetProfile(void) {}
+inline uint64_t GetAllocationCount(void) { return 0; }
+inline uint64_t GetFrameAllocationCount(void) { return 0; }
+inline bool SaveProfileCsv(const char *) { return false; }
+inline bool SaveProfileJson(const char *) { return false; }
+inline void UpdateProfilerOverlay(void) {}
+inline void DrawProfilerOverlay(void) {}
+
+#define SNAKE_PROFILE_SCOPE(section) ((void)0)
+#define SNAKE_PROFILE_FRAME_END() ((void)0)
+
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// Pcg32: 每局自带的随机数发生器 (PCG-XSH-RR, 64 位状态, 32 位输出)
+// - 只有两个 uint64, 可以平凡复制, 不依赖全局状态, 多个实例之间没有竞争
+// - 同一个 (seed, stream) 在所有平台上产生同样的序列, 不同 stream 的序列互不相关
+// - Bounded 用 Lemire 的乘法 + 拒绝采样, 没有取模偏差, 通常不需要除法
+// ------------------------------------------------------------------------------------
+class Pcg32
+{
+public:
+    Pcg32(void) : state(0x853c49e6748fea9bull), increment(0xda3e39cb94b95bdbull) {}
+    Pcg32(uint64_t seed, uint64_t stream = 0) { Seed(seed, stream); }
+
+    void Seed(uint64_t seed, uint64_t stream = 0)
+    {
+        state = 0;
+        increment = (stream << 1) | 1; // 增量必须是奇数
+        Next();
+        state += seed;
+        Next();
+    }
+
+    uint32_t Next(void)
+    {
+        uint64_t old = state;
+        state = old * 6364136223846793005ull + increment;
+        uint32_t xorShifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = (uint32_t)(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    // [0, range) 上的均匀整数, range 必须大于 0
+    uint32_t Bounded(uint32_t range)
+    {
+        uint64_t product = (uint64_t)Next() * range;
+        uint32_t low = (uint32_t)product;
+        if (low < range)
+        {
+            // 只有落在 2^32 mod range 之内的低位需要拒绝
+            uint32_t threshold = (0u - range) % range;
+            while (low < threshold)
+            {
+                product = (uint64_t)Next() * range;
+                low = (uint32_t)product;
+            }
+        }
+        return (uint32_t)(product >> 32);
+    }
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "Simulation.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// Replay: 录像 = 开局参数 + 转向事件, 不保存任何逐帧画面或状态
+// Simulation 是确定性的, 同样的 (棋盘, seed, stream) 加上同样的转向序列一定得到同一局
+//
+// 每个转向事件编码成一个 varint: (距离上一个事件的 tick 数 << 2) | 方向 (2 bit),
+// 正常操作下一次转向只占 1~2 字节; 文件头里记录最终的 tick 数, 分数和结局, 用于校验
+//
+// 文件格式 (小端):
+//   "SNKR" | version u8 | width u16 | height u16 | seed u64 | stream u64
+//   | tickCount u64 | score i32 | status u8 | eventCount u32 | byteCount u32 | events...
+// ------------------------------------------------------------------------------------
+
+struct Replay
+{
+    int width;
+    int height;
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t tickCount;          // 录制结束时的 tick 数
+    int32_t score;               // 录制结束时的分数
+    SimStatus status;            // 录制结束时的状态
+    uint32_t eventCount;         // 转向事件数
+    std::vector<uint8_t> events; // varint 编码的转向事件
+};
+
+bool SaveReplay(const char *fileName, const Replay &replay);
+bool LoadReplay(const char *fileName, Replay &replay); // 格式不对, 每边超过 MAX_BOARD_SIZE 或者数据不完整时返回 false
+
+// 录制: 每个 tick 之后报告实际生效的方向, 只有方向变化时才写入一个事件
+class ReplayRecorder
+{
+public:
+    ReplayRecorder(void);
+
+    // 开始录制新的一局; 缓冲区只在第一次或者录像变长时分配
+    void Begin(int width, int height, uint64_t seed, uint64_t stream, SnakeDirection initialDirection);
+    void RecordTick(uint64_t tick, SnakeDirection direction); // tick 从 1 开始, 即 Step 之后的 Ticks()
+    void Finish(uint64_t tickCount, int score, SimStatus status);
+
+    const Replay &GetReplay(void) const { return replay; }
+
+private:
+    Replay replay;
+    uint64_t lastEventTick;
+    SnakeDirection lastDirection;
+};
+
+// 按顺序解码转向事件; 状态很小, 可以直接复制保存到检查点里
+struct ReplayCursor
+{
+    size_t offset;            // 下一个事件在 events 中的字节位置
+    uint64_t nextTick;        // 下一个事件生效的 tick, 没有更多事件时为 0
+    SnakeDirection nextDirection;
+    uint64_t lastTick;        // 上一个事件的 tick (delta 的基准)
+
+    void Begin(const Replay &replay);
+    void Advance(const Replay &replay); // 解码下一个事件
+};
+
+// 回放: 无窗口地重新模拟, 每隔 CheckpointInterval() 个 tick 保存一次完整状态,
+// Seek 从最近的检查点出发, 最多重新模拟 CheckpointInterval() - 1 个 tick
+//
+// 检查点的总大小不超过 MAX_CHECKPOINT_BYTES (DynamicBoard 的状态和格子数成正比, 4096x4096
+// 的棋盘一个检查点就有约 200 MB): 存满时隔一个丢掉一个, 间隔加倍, 所以内存有上限,
+// 代价是 Seek 要重新模拟的 tick 变多; 40x30 的棋盘上要上千万个 tick 才会开始加倍
+template <class Board>
+class BasicReplayPlayer
+{
+public:
+    static const uint64_t CHECKPOINT_INTERVAL = 1024;       // 初始 (也是最小) 的间隔
+    static const size_t MAX_CHECKPOINT_BYTES = 256u << 20; // 至少保留 2 个检查点, 即使单个超过这个预算
+
+    BasicReplayPlayer(void) : replay(nullptr), sim(), cursor{}, interval(CHECKPOINT_INTERVAL), maxCheckpoints(2) {}
+
+    // board 的大小必须和录像一致; checkpointBytes 是检查点的内存预算
+    bool Open(const Replay &source, const Board &board, size_t checkpointBytes = MAX_CHECKPOINT_BYTES);
+
+    StepResult Step(void);                // 前进一个 tick; 到达录像结尾后不再前进
+    void Seek(uint64_t tick);             // 跳到第 tick 个 tick 之后的状态 (超出结尾时停在结尾)
+    bool AtEnd(void) const { return sim.Ticks() >= replay->tickCount || !sim.Running(); }
+    bool Matches(void) const;             // 播放到结尾后和录像记录的结局是否一致
+
+    uint64_t CheckpointInterval(void) const { return interval; }
+    size_t CheckpointCount(void) const { return checkpoints.size(); }
+
+    const BasicSimulation<Board> &GetSimulation(void) const { return sim; }
+
+private:
+    struct Checkpoint
+    {
+        BasicSimulation<Board> sim;
+        ReplayCursor cursor;
+    };
+
+    static size_t CheckpointBytes(const Board &board); // 一个检查点占用的内存 (包括 DynamicBoard 的堆上存储)
+    void SaveCheckpoint(void);
+    void ThinCheckpoints(void); // 隔一个丢掉一个, 间隔加倍
+
+    const Replay *replay;
+    BasicSimulation<Board> sim;
+    ReplayCursor cursor;
+    uint64_t interval;
+    size_t maxCheckpoints;
+    std::vector<Checkpoint> checkpoints; // checkpoints[k] 是第 k * interval 个 tick 的状态
+};
+
+template <class Board>
+bool BasicReplayPlayer<Board>::Open(const Replay &source, const Board &board, size_t checkpointBytes)
+{
+    if (source.width != board.Width() || source.height != board.Height())
+        return false;
+
+    replay = &source;
+    sim.Reset(board, source.seed, source.stream);
+    cursor.Begin(source);
+    interval = CHECKPOINT_INTERVAL;
+    maxCheckpoints = std::max<size_t>(2, checkpointBytes / CheckpointBytes(board));
+    checkpoints.clear();
+    checkpoints.reserve(std::min((size_t)(source.tickCount / interval) + 1, maxCheckpoints));
+    SaveCheckpoint();
+    return true;
+}
+
+template <class Board>
+size_t BasicReplayPlayer<Board>::CheckpointBytes(const Board &board)
+{
+    size_t bytes = sizeof(Checkpoint);
+    if constexpr (!std::is_trivially_copyable<BasicSimulation<Board>>::value)
+    {
+        // 蛇身的环形缓冲区, 占用位图, 空闲格子的排列和反向索引
+        const size_t cells = (size_t)board.CellCount();
+        bytes += cells * (sizeof(SnakeSegment) + 2 * sizeof(int32_t)) + (cells + 63) / 64 * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+template <class Board>
+void BasicReplayPlayer<Board>::SaveCheckpoint(void)
+{
+    if (checkpoints.size() == maxCheckpoints)
+    {
+        ThinCheckpoints();
+        if (sim.Ticks() % interval != 0)
+            return; // 不在新的间隔上, 等下一个
+    }
+
+    checkpoints.emplace_back();
+    CopyState(checkpoints.back().sim, sim);
+    checkpoints.back().cursor = cursor;
+}
+
+template <class Board>
+void BasicReplayPlayer<Board>::ThinCheckpoints(void)
+{
+    // 保留第 0, 2, 4, ... 个, 它们正好落在加倍之后的间隔上
+    size_t kept = 0;
+    for (size_t i = 0; i < checkpoints.size(); i += 2)
+    {
+        if (kept != i)
+            CopyState(checkpoints[kept].sim, checkpoints[i].sim);
+        checkpoints[kept].cursor = checkpoints[i].cursor;
+        kept++;
+    }
+    checkpoints.resize(kept);
+    interval *= 2;
+}
+
+template <class Board>
+StepResult BasicReplayPlayer<Board>::Step(void)
+{
+    if (AtEnd())
+        return StepResult{};
+
+    // 没有事件的 tick 保持当前方向
+    SnakeDirection input = sim.Direction();
+    if (cursor.nextTick == sim.Ticks() + 1)
+    {
+        input = cursor.nextDirection;
+        cursor.Advance(*replay);
+    }
+    StepResult result = sim.Step(input);
+
+    // 第一次经过检查点的位置时保存状态
+    if (sim.Ticks() % interval == 0 && sim.Ticks() / interval == checkpoints.size())
+        SaveCheckpoint();
+    return result;
+}
+
+template <class Board>
+void BasicReplayPlayer<Board>::Seek(uint64_t tick)
+{
+    if (tick > replay->tickCount)
+        tick = replay->tickCount;
+
+    // 目标在已保存的检查点范围内: 先回到不晚于目标的最近检查点 (当前位置更近时直接往前走)
+    size_t index = (size_t)(tick / interval);
+    if (index >= checkpoints.size())
+        index = checkpoints.size() - 1;
+
+    uint64_t checkpointTick = (uint64_t)index * interval;
+    if (sim.Ticks() > tick || sim.Ticks() < checkpointTick)
+    {
+        CopyState(sim, checkpoints[index].sim);
+        cursor = checkpoints[index].cursor;
+    }
+
+    while (sim.Ticks() < tick && !AtEnd())
+    {
+        Step();
+    }
+}
+
+template <class Board>
+bool BasicReplayPlayer<Board>::Matches(void) const
+{
+    return sim.Ticks() == replay->tickCount && sim.Score() == replay->score && sim.Status() == replay->status;
+}
+
+// 常用的棋盘在 Replay.cpp 里显式实例化
+extern template class BasicReplayPlayer<DynamicBoard>;
+extern template class BasicReplayPlayer<ClassicBoard>;
+
+typedef BasicReplayPlayer<DynamicBoard> ReplayPlayer;
+typedef BasicReplayPlayer<ClassicBoard> ClassicReplayPlayer;
@@ -0,0 +1,34 @@
+#pragma once
+
+class Game;
+
+// 所有画面
+typedef enum
+{
+    SCREEN_MENU = 0,
+    SCREEN_OPTIONS,
+    SCREEN_PLAY,
+    SCREEN_VERSUS,
+    SCREEN_ONLINE,
+    SCREEN_GAME_OVER,
+    SCREEN_COUNT
+} ScreenId;
+
+// ------------------------------------------------------------------------------------
+// Screen: 画面基类
+// 每个画面在启动时构造并 Load 一次, 之后在切换中反复复用, 切换时不分配内存也不重新加载资源
+// ------------------------------------------------------------------------------------
+class Screen
+{
+public:
+    virtual ~Screen(void) {}
+
+    virtual void Load(void) {}   // Create resources (called once after InitWindow)
+    virtual void Unload(void) {} // Release resources (called once before CloseWindow)
+
+    virtual void Enter(Game &) {} // 切换到这个画面时调用
+    virtual void Exit(Game &) {}  // 离开这个画面时调用
+
+    virtual void Update(Game &game, float frameTime) = 0; // Update screen (one frame)
+    virtual void Draw(const Game &game) = 0;              // Draw screen (one frame)
+};
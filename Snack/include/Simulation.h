@@ -0,0 +1,255 @@
+#pragma once
+
+#include "Board.h"
+#include "Cell.h"
+#include "Food.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "Snacke.h"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// ------------------------------------------------------------------------------------
+// Simulation: 纯游戏逻辑, 不依赖 raylib (没有窗口, 输入, 计时和音效)
+// 调用方每个 tick 传入期望的方向, 根据返回的事件自行播放音效或刷新画面
+// 模板参数 Board 决定棋盘大小是编译期常量 (FixedBoard) 还是运行时决定 (DynamicBoard)
+//
+// 一局游戏的全部状态都在这一个对象里, 没有全局变量也没有指针:
+// - FixedBoard 的状态是一整块连续内存 (蛇身, 位图, 空闲格子都是内嵌的 std::array),
+//   可以平凡复制, 用 memcpy 就能做快照或搬到别的位置, 成千上万局可以放在一个数组里
+// - DynamicBoard 的存储在堆上, 快照时按值复制
+// ------------------------------------------------------------------------------------
+
+// 蛇的移动方向
+typedef enum
+{
+    DIR_RIGHT = 0,
+    DIR_LEFT,
+    DIR_UP,
+    DIR_DOWN
+} SnakeDirection;
+
+// 一局游戏的状态
+typedef enum
+{
+    SIM_RUNNING = 0,
+    SIM_DEAD, // 撞墙或撞到自己
+    SIM_WON   // 蛇占满了整个棋盘
+} SimStatus;
+
+// 一个 tick 中发生的事件
+struct StepResult
+{
+    bool ateFood;   // 吃到了食物 (蛇身变长, 尾巴没有移动)
+    bool died;      // 本 tick 撞墙或撞到自己
+    bool won;       // 本 tick 占满了棋盘
+    bool tailMoved; // 本 tick 移除了蛇尾
+    Cell prevHead;  // 移动前的蛇头
+    Cell prevTail;  // 被移除的蛇尾 (tailMoved 为 true 时有效)
+};
+
+inline bool IsOpposite(SnakeDirection a, SnakeDirection b)
+{
+    // 枚举按 RIGHT/LEFT, UP/DOWN 成对排列
+    return (a ^ 1) == b;
+}
+
+inline Cell MoveCell(Cell position, SnakeDirection dir)
+{
+    switch (dir)
+    {
+    case DIR_RIGHT:
+        position.x++;
+        break;
+    case DIR_LEFT:
+        position.x--;
+        break;
+    case DIR_UP:
+        position.y--;
+        break;
+    case DIR_DOWN:
+        position.y++;
+        break;
+    }
+    return position;
+}
+
+template <class Board>
+class alignas(64) BasicSimulation
+{
+public:
+    BasicSimulation(void);
+
+    // 开始新的一局; 区域大小不变时不会重新分配内存
+    // 同样的 (seed, stream) 和同样的输入序列总是得到同样的一局, 与平台无关
+    void Reset(const Board &newBoard, uint64_t seed, uint64_t stream = 0);
+
+    // 推进一个 tick; input 与当前方向相反时被忽略
+    StepResult Step(SnakeDirection input);
+
+    // 推进一个 tick, 新方向, 新蛇头, 是否撞墙和是否吃到食物已经由调用方算好
+    // (批量模式下由 SIMD 内核一次算出很多局); 结果必须和 Step 自己算的一致
+    StepResult ApplyMove(SnakeDirection newDirection, Cell newHeadPos, bool hitWall, bool hitFood);
+
+    const Board &GetBoard(void) const { return board; }
+    int Width(void) const { return board.Width(); }
+    int Height(void) const { return board.Height(); }
+    SimStatus Status(void) const { return status; }
+    bool Running(void) const { return status == SIM_RUNNING; }
+    SnakeDirection Direction(void) const { return direction; }
+    int Score(void) const { return score; }
+    uint64_t Ticks(void) const { return ticks; }
+
+    const BasicSnake<Board> &GetSnake(void) const { return snake; }
+    const Food &GetFood(void) const { return food; }
+
+    bool InBounds(Cell position) const { return board.Contains(position); }
+
+    // 蛇头移动到这个格子是否会死 (撞墙或撞到除尾巴以外的身体)
+    bool IsDeadly(Cell position) const
+    {
+        return !board.Contains(position) || (snake.IsOccupied(position) && position != snake.Tail().position);
+    }
+
+private:
+    void PushHead(Cell position); // Grow the snake at the head, keeping the free-cell index in sync
+    void PopTail(void);           // Drop the tail cell, keeping the free-cell index in sync
+
+    // 成员按访问频率排列: 每个 tick 都要用的小字段放在同一条缓存行里, 大块存储在后
+    SimStatus status;
+    SnakeDirection direction;
+    int score;
+    uint64_t ticks;
+    Food food;
+    Board board;
+    BasicSnake<Board> snake;
+    BasicFoodSpawner<Board> foodSpawner; // 空闲格子索引, 与蛇的身体同步更新 (只在吃到食物时访问)
+    Pcg32 rng; // 每局独立的随机数流, 只用于生成食物
+};
+
+template <class Board>
+BasicSimulation<Board>::BasicSimulation(void)
+    : status(SIM_DEAD), direction(DIR_RIGHT), score(0), ticks(0), food{}, board()
+{
+}
+
+template <class Board>
+void BasicSimulation<Board>::Reset(const Board &newBoard, uint64_t seed, uint64_t stream)
+{
+    board = newBoard;
+    rng.Seed(seed, stream);
+    status = SIM_RUNNING;
+    direction = DIR_RIGHT;
+    score = 0;
+    ticks = 0;
+
+    const int width = board.Width();
+    const int height = board.Height();
+
+    // 容量按整个游戏区域预分配, 之后移动时不再分配内存
+    snake.Reset(board);
+    foodSpawner.Reset(board);
+    // 从蛇尾往蛇头依次压入, 初始时多几节身体
+    PushHead({(int16_t)(width / 2 - 2), (int16_t)(height / 2)});
+    PushHead({(int16_t)(width / 2 - 1), (int16_t)(height / 2)});
+    // 蛇头
+    PushHead({(int16_t)(width / 2), (int16_t)(height / 2)});
+
+    foodSpawner.Spawn(food, rng);
+}
+
+template <class Board>
+StepResult BasicSimulation<Board>::Step(SnakeDirection input)
+{
+    if (status != SIM_RUNNING)
+        return StepResult{};
+
+    SnakeDirection newDirection = IsOpposite(input, direction) ? direction : input; // 防止 180 度转向
+    Cell newHeadPos = MoveCell(snake.Head().position, newDirection);
+    return ApplyMove(newDirection, newHeadPos, !board.Contains(newHeadPos), food.active && newHeadPos == food.position);
+}
+
+template <class Board>
+StepResult BasicSimulation<Board>::ApplyMove(SnakeDirection newDirection, Cell newHeadPos, bool hitWall, bool hitFood)
+{
+    StepResult result = {};
+    if (status != SIM_RUNNING)
+        return result;
+
+    ticks++;
+    direction = newDirection;
+    result.prevHead = snake.Head().position;
+
+    // --- 碰撞检测: 撞墙, 或撞自己身体 (查占用位图，不包括尾巴，因为尾巴马上要移动) ---
+    if (hitWall || (snake.IsOccupied(newHeadPos) && newHeadPos != snake.Tail().position))
+    {
+        status = SIM_DEAD;
+        result.died = true;
+        return result;
+    }
+
+    // --- 检查是否吃到食物 ---
+    result.ateFood = hitFood;
+
+    // --- 移动蛇身体 ---
+    // 如果没有吃到食物，先移除蛇尾 (蛇身体向前移动的效果), 保证环形缓冲区不会溢出
+    if (!result.ateFood)
+    {
+        result.tailMoved = true;
+        result.prevTail = snake.Tail().position;
+        PopTail();
+    }
+    // 将新头压到最前面 (O(1), 不搬动身体)
+    PushHead(newHeadPos);
+
+    if (result.ateFood)
+    {
+        score += 10;
+        // 直接从空闲格子里随机挑一个, 一次完成; 没有空闲格子说明蛇已占满棋盘
+        bool spawned;
+        {
+            SNAKE_PROFILE_SCOPE(PROFILE_SPAWN_FOOD);
+            spawned = foodSpawner.Spawn(food, rng);
+        }
+        if (!spawned)
+        {
+            status = SIM_WON;
+            result.won = true;
+        }
+    }
+    return result;
+}
+
+template <class Board>
+void BasicSimulation<Board>::PushHead(Cell position)
+{
+    snake.PushHead({position});
+    foodSpawner.Occupy(position);
+}
+
+template <class Board>
+void BasicSimulation<Board>::PopTail(void)
+{
+    foodSpawner.Release(snake.Tail().position);
+    snake.PopTail();
+}
+
+// 复制一局游戏的全部状态 (快照 / 恢复); 编译期大小的棋盘直接 memcpy
+template <class Board>
+inline void CopyState(BasicSimulation<Board> &destination, const BasicSimulation<Board> &source)
+{
+    if constexpr (std::is_trivially_copyable<BasicSimulation<Board>>::value)
+        memcpy((void *)&destination, (const void *)&source, sizeof(source));
+    else
+        destination = source;
+}
+
+// 常用的棋盘在 Simulation.cpp 里显式实例化
+extern template class BasicSimulation<DynamicBoard>;
+extern template class BasicSimulation<ClassicBoard>;
+
+typedef BasicSimulation<DynamicBoard> Simulation;        // 运行时大小 (后备实现)
+typedef BasicSimulation<ClassicBoard> ClassicSimulation; // 窗口版的 40x30 棋盘
+
+static_assert(std::is_trivially_copyable<ClassicSimulation>::value, "fixed-board state must be memcpy-able");
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Board.h"
+#include "Cell.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// Snake Structures
+// ------------------------------------------------------------------------------------
+struct SnakeSegment
+{
+    Cell position; // 格子坐标 (不是像素坐标)
+};
+
+// 蛇的身体: 固定容量的环形缓冲区
+// 下标 0 是蛇头, Size() - 1 是蛇尾; PushHead / PopTail 都是 O(1), 游戏过程中不再分配内存
+// 同时维护一张占用位图 (每个格子 1 bit), 碰撞检测和食物生成都只需查一次位图
+template <class Board>
+class BasicSnake
+{
+public:
+    BasicSnake(void) : head(0), length(0), board(), occupancy(), segments() {}
+
+    void Reset(const Board &newBoard); // 清空身体, 区域大小变化时才重新分配 (只在初始化时调用)
+    void PushHead(const SnakeSegment &segment);
+    void PopTail(void);
+
+    size_t Size(void) const { return length; }
+    size_t Capacity(void) const { return segments.size(); }
+    bool Empty(void) const { return length == 0; }
+
+    const SnakeSegment &Head(void) const { return segments[head]; }
+    const SnakeSegment &Tail(void) const { return (*this)[length - 1]; }
+    const SnakeSegment &operator[](size_t i) const { return segments[Wrap(head + i)]; }
+
+    // 格子是否被蛇身体占用; 调用方保证坐标在游戏区域内
+    bool IsOccupied(Cell position) const
+    {
+        int cell = board.Index(position);
+        return (occupancy[cell >> 6] >> (cell & 63)) & 1u;
+    }
+
+private:
+    size_t Wrap(size_t i) const { return (i >= segments.size()) ? i - segments.size() : i; }
+
+    // 成员按访问频率排列: 每个 tick 都要读的下标在前, 大块存储在后
+    // 只用下标不用指针, 整个对象可以按字节复制到任何位置
+    size_t head;   // 蛇头在 segments 中的位置
+    size_t length; // 当前身体长度
+    Board board;
+
+    typename Board::Bitmap occupancy;                          // 占用位图, 每个格子 1 bit
+    typename Board::template CellArray<SnakeSegment> segments; // 预分配的存储空间
+};
+
+template <class Board>
+void BasicSnake<Board>::Reset(const Board &newBoard)
+{
+    board = newBoard;
+    ResizeStorage(segments, (size_t)board.CellCount());
+    ResizeStorage(occupancy, (size_t)(board.CellCount() + 63) / 64);
+    std::fill(occupancy.begin(), occupancy.end(), 0);
+    head = 0;
+    length = 0;
+}
+
+template <class Board>
+void BasicSnake<Board>::PushHead(const SnakeSegment &segment)
+{
+    // 调用方保证 length < Capacity(): 不吃食物时先 PopTail 再 PushHead
+    head = (head == 0) ? segments.size() - 1 : head - 1;
+    segments[head] = segment;
+    length++;
+
+    int cell = board.Index(segment.position);
+    occupancy[cell >> 6] |= (uint64_t)1 << (cell & 63);
+}
+
+template <class Board>
+void BasicSnake<Board>::PopTail(void)
+{
+    // 蛇尾只是逻辑上移除, 不需要搬动任何数据
+    int cell = board.Index(Tail().position);
+    occupancy[cell >> 6] &= ~((uint64_t)1 << (cell & 63));
+    length--;
+}
+
+// 常用的棋盘在 Snacke.cpp 里显式实例化
+extern template class BasicSnake<DynamicBoard>;
+extern template class BasicSnake<ClassicBoard>;
+
+typedef BasicSnake<DynamicBoard> Snake;
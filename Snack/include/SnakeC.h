@@ -0,0 +1,81 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------
+// SnakeC: 批量模拟的 C ABI, 供 Python (ctypes) 等其它语言调用
+// - 所有输入输出都是调用方提供的连续缓冲区 (NumPy 数组直接传 data 指针即可),
+//   库在 Step / Observe 中直接写进去, 不复制中间结果, 也不分配内存
+// - 结束的局在 Step 里原地重置, 写出的观测已经是新一局的第一帧
+// - 所有数组都按局数排在最外层: grid 是 [count][height][width], heads / foods 是 [count][2] (x, y)
+// ------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(SNAKE_C_BUILD)
+#define SNAKE_API __declspec(dllexport)
+#else
+#define SNAKE_API __declspec(dllimport)
+#endif
+#else
+#define SNAKE_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SNAKE_C_VERSION 1
+
+// grid 中每个格子的取值
+#define SNAKE_CELL_EMPTY 0
+#define SNAKE_CELL_BODY 1
+#define SNAKE_CELL_HEAD 2
+#define SNAKE_CELL_FOOD 3
+
+// 一局在一次 Step 里的结果, 12 字节, 布局固定 (NumPy 结构化 dtype 可以直接映射)
+typedef struct SnakeStepInfo
+{
+    int8_t reward;         // +1 吃到食物, -1 死亡, 0 其它
+    uint8_t done;          // 这一局在本次 Step 结束并已经重置
+    uint8_t won;           // 结束的原因是占满了棋盘
+    uint8_t reserved;
+    int32_t episodeScore;  // done 时为结束那一局的分数
+    uint32_t episodeTicks; // done 时为结束那一局的 tick 数
+} SnakeStepInfo;
+
+// 观测的输出位置, 不需要的字段传 NULL
+typedef struct SnakeObservation
+{
+    uint8_t *grid;    // [count][height][width], SNAKE_CELL_*
+    int16_t *heads;   // [count][2]
+    int16_t *foods;   // [count][2], 没有食物时为 (-1, -1)
+    int32_t *lengths; // [count]
+} SnakeObservation;
+
+typedef struct SnakeEnv SnakeEnv;
+
+SNAKE_API int SnakeVersion(void);
+
+// width 为 3 ~ 4096, height 为 1 ~ 4096 (MAX_BOARD_SIZE); threads = 0 使用全部硬件线程;
+// 参数无效或者创建失败 (内存不足, 无法启动线程) 时返回 NULL
+SNAKE_API SnakeEnv *SnakeEnvCreate(int32_t count, int32_t width, int32_t height, uint32_t seed, int32_t threads);
+SNAKE_API void SnakeEnvDestroy(SnakeEnv *env);
+
+SNAKE_API int32_t SnakeEnvCount(const SnakeEnv *env);
+SNAKE_API int32_t SnakeEnvWidth(const SnakeEnv *env);
+SNAKE_API int32_t SnakeEnvHeight(const SnakeEnv *env);
+
+// 所有局重新开始, observation 可以为 NULL
+SNAKE_API void SnakeEnvReset(SnakeEnv *env, const SnakeObservation *observation);
+
+// actions: [count], 取值 0 右 1 左 2 上 3 下 (只看低 2 位); infos: [count]
+// observation 可以为 NULL; 成功返回 0
+SNAKE_API int SnakeEnvStep(SnakeEnv *env, const int32_t *actions, SnakeStepInfo *infos,
+                           const SnakeObservation *observation);
+
+// 不推进, 只写当前观测
+SNAKE_API void SnakeEnvObserve(SnakeEnv *env, const SnakeObservation *observation);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// 游戏速度: tick 间隔全部用整数微秒表示
+// - TickClock 是固定步长累加器: 每帧加上帧时间 (转换成微秒), 每个 tick 减去当前间隔;
+//   整数减法没有舍入, 无论间隔多短 (几毫秒, 一帧走好几个 tick) 跑多久 tick 频率都不漂移
+// - SpeedCurve 描述间隔随吃到的食物数缩短的方式, 只在吃到食物时重新计算一次间隔,
+//   不吃东西的 tick 没有任何额外开销
+// ------------------------------------------------------------------------------------
+
+typedef enum
+{
+    SPEED_CLASSIC = 0, // 固定 150 ms
+    SPEED_GENTLE,
+    SPEED_FAST,
+    SPEED_INSANE,      // 最快 5 ms, 60 FPS 下一帧走三四个 tick
+    SPEED_CURVE_COUNT
+} SpeedCurveId;
+
+struct SpeedCurve
+{
+    uint32_t startMicros; // 开局的间隔
+    uint32_t minMicros;   // 最短的间隔
+    uint32_t stepMicros;  // 每一档缩短的微秒数
+    uint32_t foodPerStep; // 吃多少个食物升一档
+    const char *label;    // 选项画面上的文字
+};
+
+const SpeedCurve &GetSpeedCurve(SpeedCurveId id);
+
+// 吃了 foodEaten 个食物之后的 tick 间隔
+inline uint32_t SpeedInterval(const SpeedCurve &curve, uint32_t foodEaten)
+{
+    uint64_t shrink = (uint64_t)(foodEaten / curve.foodPerStep) * curve.stepMicros;
+    if (shrink >= curve.startMicros - curve.minMicros)
+        return curve.minMicros;
+    return curve.startMicros - (uint32_t)shrink;
+}
+
+class TickClock
+{
+public:
+    TickClock(void) : accumulated(0), interval(1) {}
+
+    // 重新开始计时 (开局)
+    void Reset(uint32_t intervalMicros)
+    {
+        accumulated = 0;
+        interval = intervalMicros > 0 ? intervalMicros : 1;
+    }
+
+    // 换一个间隔, 已经累计的时间保留 (吃到食物加速时不会顿一下)
+    void SetInterval(uint32_t intervalMicros) { interval = intervalMicros > 0 ? intervalMicros : 1; }
+
+    void Advance(float frameSeconds) { accumulated += (int64_t)(frameSeconds * 1000000.0f + 0.5f); }
+
+    // 累计的时间够一个 tick 时消耗掉它并返回 true
+    bool Consume(void)
+    {
+        if (accumulated < interval)
+            return false;
+        accumulated -= interval;
+        return true;
+    }
+
+    // 追赶达到上限时丢弃积压的时间, 而不是在之后的帧里继续追
+    void DropBacklog(void)
+    {
+        if (accumulated >= interval)
+            accumulated = 0;
+    }
+
+    uint32_t Interval(void) const { return interval; }
+    float Alpha(void) const { return (float)accumulated / (float)interval; } // 到下一个 tick 的进度, 用于插值绘制
+
+private:
+    int64_t accumulated; // 还没有被模拟消耗掉的微秒
+    uint32_t interval;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// ------------------------------------------------------------------------------------
+// SpscQueue: 单生产者 / 单消费者的无锁环形队列, 容量是编译期常量
+// 生产者只写 tail, 消费者只写 head, 两边各自用 acquire / release 看到对方的进度;
+// 生产者和消费者可以在不同线程 (例如独立的输入线程), 也可以是同一个线程
+// 满了时 Push 返回 false (丢弃新元素), 不会覆盖还没消费的元素
+// ------------------------------------------------------------------------------------
+template <class T, size_t N>
+class SpscQueue
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+    SpscQueue(void) : head(0), tail(0) {}
+
+    // 生产者
+    bool Push(const T &value)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == N)
+            return false;
+
+        items[t & (N - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者
+    bool Pop(T &value)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+
+        value = items[h & (N - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Empty(void) const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+    // 消费者: 丢弃所有还没消费的元素
+    void Clear(void) { head.store(tail.load(std::memory_order_acquire), std::memory_order_release); }
+
+private:
+    // head 和 tail 分在不同的缓存行, 两个线程互不干扰
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+    T items[N];
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Simulation.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+// ------------------------------------------------------------------------------------
+// StatsStore: 持久化的战绩 (每局的分数, 长度, 时长, tick 数) 和排行榜
+// - 磁盘上是一个只追加的二进制日志, 每局一条定长记录; 启动时读一遍建立内存里的索引
+//   (前 LEADERBOARD_SIZE 名 + 累计统计), 之后只在内存里更新
+// - Record 在游戏线程上调用: 只更新索引并把记录放进无锁队列, 写盘和 fflush 在后台线程上,
+//   所以保存不会卡住任何一帧
+// - 程序中途退出时最后一条记录可能只写了一半, 读取时靠长度和校验和丢弃
+//
+// 文件格式 (小端):
+//   "SNKS" | version u8 | reserved u8[3]
+//   | 记录: timestamp i64 | ticks u64 | score i32 | length u32 | durationMillis u32
+//   |       width u16 | height u16 | status u8 | flags u8 | reserved u16 | checksum u32
+// ------------------------------------------------------------------------------------
+
+struct GameRecord
+{
+    int64_t timestamp;       // 结束时间 (Unix 秒)
+    uint64_t ticks;
+    int32_t score;
+    uint32_t length;         // 结束时蛇的长度
+    uint32_t durationMillis; // 实际游玩的时间, 不含暂停
+    uint16_t width;
+    uint16_t height;
+    SimStatus status;
+    bool autopilot;          // 自动驾驶参与过的局不进排行榜
+};
+
+class StatsStore
+{
+public:
+    static const int LEADERBOARD_SIZE = 5;
+
+    StatsStore(void);
+    ~StatsStore(void) { Close(); }
+
+    StatsStore(const StatsStore &) = delete;
+    StatsStore &operator=(const StatsStore &) = delete;
+
+    // 读已有的记录建立索引并启动写入线程; 文件不存在时新建, 打不开时只在内存里统计
+    void Open(const char *fileName);
+    void Close(void); // 写完排队的记录后结束写入线程
+
+    // 游戏线程: 更新索引并排队写盘, 返回这一局在排行榜上的名次 (0 起), 没进榜为 -1
+    int Record(const GameRecord &record);
+
+    int LeaderboardCount(void) const { return leaderboardCount; }
+    const GameRecord &Leaderboard(int rank) const { return leaderboard[rank]; }
+
+    uint64_t GamesPlayed(void) const { return gamesPlayed; }
+    uint64_t TotalTicks(void) const { return totalTicks; }
+    uint64_t TotalMillis(void) const { return totalMillis; }
+    uint32_t BestLength(void) const { return bestLength; }
+
+    // 队列满了或者写盘失败时丢掉的记录 (内存里的索引仍然包含它们)
+    uint64_t DroppedRecords(void) const { return dropped + writeFailures.load(); }
+
+private:
+    static const size_t QUEUE_SIZE = 64;
+
+    int Index(const GameRecord &record); // 更新排行榜和累计统计
+    void WriterMain(void);
+
+    GameRecord leaderboard[LEADERBOARD_SIZE]; // 按分数从高到低, 同分时 tick 少的在前
+    int leaderboardCount;
+    uint64_t gamesPlayed;
+    uint64_t totalTicks;
+    uint64_t totalMillis;
+    uint32_t bestLength;
+    uint64_t dropped;
+
+    FILE *file; // 只有写入线程使用
+    SpscQueue<GameRecord, QUEUE_SIZE> pending;
+    std::thread writer;
+    std::mutex wakeMutex; // 只保护睡眠 / 唤醒, 写盘时不持有
+    std::condition_variable wake;
+    std::atomic<bool> stopping;
+    std::atomic<uint64_t> writeFailures;
+};
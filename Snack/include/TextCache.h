@@ -0,0 +1,53 @@
+#pragma once
+
+#include "raylib.h"
+
+// ------------------------------------------------------------------------------------
+// 文字缓存: 避免每帧都调用 TextFormat / MeasureText
+// ------------------------------------------------------------------------------------
+
+// 带一个整数参数的文字 (例如 "Score: %i"), 只有数值变化时才重新格式化和测量宽度
+class CachedNumberText
+{
+public:
+    CachedNumberText(const char *format, int fontSize);
+
+    void Set(int value);
+
+    const char *Text(void) const { return text; }
+    int Width(void) const { return width; }
+    int FontSize(void) const { return fontSize; }
+
+    void Draw(int x, int y, Color color) const { DrawText(text, x, y, fontSize, color); }
+    void DrawCentered(int centerX, int y, Color color) const { Draw(centerX - width / 2, y, color); }
+
+private:
+    const char *format;
+    int fontSize;
+    int value;
+    bool valid;
+    int width;
+    char text[64];
+};
+
+// 固定不变的文字 (例如 "GAME OVER"), 加载时预先光栅化到一张纹理上, 之后每次只需贴图
+class StaticLabel
+{
+public:
+    StaticLabel(const char *text, int fontSize, Color color);
+
+    void Load(void);   // Rasterize the text (call after InitWindow)
+    void Unload(void); // Release the texture (call before CloseWindow)
+
+    int Width(void) const { return width; }
+
+    void Draw(int x, int y) const;
+    void DrawCentered(int centerX, int y) const { Draw(centerX - width / 2, y); }
+
+private:
+    const char *text;
+    int fontSize;
+    Color color;
+    int width;
+    RenderTexture2D texture;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// ThreadPool: 常驻工作线程 + 动态分块的并行 for
+// 任务被切成固定大小的块, 每个线程 (包括调用线程) 做完一块就从共享的原子计数器里
+// 取下一块, 先做完的线程自然会分走慢线程剩下的工作; 每次调用不分配内存
+// ------------------------------------------------------------------------------------
+class ThreadPool
+{
+public:
+    explicit ThreadPool(int threadCount = 0); // 0 = 使用全部硬件线程
+    ~ThreadPool(void);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int ThreadCount(void) const { return (int)workers.size() + 1; } // 包括调用线程
+
+    // 把 [0, count) 切成 grain 大小的块并行执行 fn(begin, end), 返回时全部完成
+    template <class Fn>
+    void ParallelFor(int count, int grain, Fn &&fn)
+    {
+        Run(&Invoke<Fn>, (void *)&fn, count, grain);
+    }
+
+private:
+    typedef void (*JobFunction)(void *context, int begin, int end);
+
+    template <class Fn>
+    static void Invoke(void *context, int begin, int end)
+    {
+        (*(Fn *)context)(begin, end);
+    }
+
+    void Run(JobFunction function, void *context, int count, int grain);
+    void RunChunks(void);
+    void WorkerLoop(void);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;     // 有新任务
+    std::condition_variable finished; // 所有工作线程都做完了
+    uint64_t generation;              // 每发布一个任务加一
+    int pending;                      // 还没做完当前任务的工作线程数
+    bool stopping;
+
+    // 当前任务
+    JobFunction job;
+    void *jobContext;
+    int jobCount;
+    int jobGrain;
+    std::atomic<int> nextChunk;
+};
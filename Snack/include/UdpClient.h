@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// UdpClient: 游戏客户端用的一个非阻塞 UDP socket (connect 到服务器, 只和它收发)
+// 在 Windows 上用 Winsock, 其它平台用 BSD socket; 头文件里不包含任何系统头文件,
+// 避免 windows.h 和 raylib.h 的名字冲突
+// ------------------------------------------------------------------------------------
+class UdpClient
+{
+public:
+    UdpClient(void) : handle(-1) {}
+    ~UdpClient(void) { Close(); }
+
+    UdpClient(const UdpClient &) = delete;
+    UdpClient &operator=(const UdpClient &) = delete;
+
+    bool Open(const char *host, uint16_t port); // host 是 IPv4 地址或主机名
+    void Close(void);
+    bool IsOpen(void) const { return handle != -1; }
+
+    bool Send(const uint8_t *data, size_t size);
+    int Receive(uint8_t *out, size_t capacity); // 没有数据时返回 -1, 不阻塞
+
+private:
+    intptr_t handle;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "MultiSimulation.h"
+#include "Screen.h"
+#include "Speed.h"
+#include "SpscQueue.h"
+#include "TextCache.h"
+#include "ViewportRenderer.h"
+
+// ------------------------------------------------------------------------------------
+// VersusScreen: 本地双人对战 (同一个键盘: 玩家 1 用 WASD, 玩家 2 用方向键)
+// 两条蛇在经典的 40x30 棋盘上同时推进, 碰撞由 MultiSimulation 的 owner 网格一遍算完
+// 每个玩家有自己的转向队列, 其余 (固定步长, 插值绘制, 暂停) 和 PlayScreen 一样
+// ------------------------------------------------------------------------------------
+class VersusScreen : public Screen
+{
+public:
+    VersusScreen(void);
+
+    void Load(void) override;
+    void Unload(void) override;
+    void Enter(Game &game) override;
+    void Update(Game &game, float frameTime) override;
+    void Draw(const Game &game) override;
+
+private:
+    static const int PLAYER_COUNT = 2;
+
+    void InitGame(void);                            // Reset the round, keeping all allocations
+    void HandleInput(void);                         // Drain this frame's key presses into the players' turn queues
+    void QueueTurn(int player, SnakeDirection dir); // Buffer one turn, dropping no-ops and reversals
+    void StepGame(void);                            // Advance both snakes by one fixed tick
+
+    ClassicMultiSimulation sim;                                // 两条蛇的游戏逻辑状态
+    ViewportRenderer renderer;                                 // 按 owner 网格上色, 棋盘正好一屏
+    SpscQueue<SnakeDirection, 4> pendingTurns[PLAYER_COUNT];   // 每个玩家还没应用的转向
+    SnakeDirection lastQueuedDir[PLAYER_COUNT];                // 每个玩家最后排队的方向
+    TickClock clock;                                           // 固定步长累加器 (整数微秒, 对战不加速)
+    float alpha;                                               // 到下一个 tick 的进度, 用于插值绘制
+    MultiStepResult lastStep;                                  // 上一个 tick 的事件, 用于插值绘制
+    bool paused;
+
+    CachedNumberText scoreTexts[PLAYER_COUNT];
+    StaticLabel pausedLabel;
+};
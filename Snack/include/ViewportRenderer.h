@@ -0,0 +1,172 @@
+#pragma once
+
+#include "raylib.h"
+#include "MultiSimulation.h"
+#include "Simulation.h"
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// ViewportRenderer: 放不进一屏的大棋盘 (最大 MAX_BOARD_SIZE x MAX_BOARD_SIZE) 的绘制
+// - 摄像机跟随插值后的蛇头, 在棋盘边缘处夹住, 只显示 viewWidth x viewHeight 个格子
+// - 每帧只查可见格子的占用位图, 写进 "每个格子一个像素" 的小纹理后一次画完;
+//   代价只和可见格子数有关, 与棋盘大小和蛇的长度无关 (屏幕外的身体完全不会被访问)
+// - 棋盘以外的格子画成墙的颜色, 蛇头和刚移走的蛇尾和 BoardRenderer 一样插值绘制
+// - 多条蛇 (VersusScreen) 按 owner 网格给每个玩家上色, 摄像机跟随第一条活着的蛇
+// ------------------------------------------------------------------------------------
+class ViewportRenderer
+{
+public:
+    ViewportRenderer(void);
+
+    void Load(int viewWidth, int viewHeight, int cellSize); // Create GPU resources (call after InitWindow)
+    void Unload(void);                                      // Release GPU resources (call before CloseWindow)
+
+    template <class Sim>
+    void Draw(const Sim &sim, const StepResult &lastStep, float alpha);
+
+    template <class Board>
+    void Draw(const BasicMultiSimulation<Board> &sim, const MultiStepResult &lastStep, float alpha);
+
+    static Color PlayerColor(int player, bool head); // 每个玩家的身体 / 蛇头颜色, 玩家 0 是单人模式的绿色
+
+private:
+    template <class Sim>
+    void FillVisible(const Sim &sim, int originX, int originY);
+    template <class Board>
+    void FillVisibleOwners(const BasicMultiSimulation<Board> &sim, int originX, int originY);
+    void ClearVisible(Cell position, int originX, int originY);
+    void PresentCells(float left, float top) const;
+    void DrawMoving(float left, float top, const StepResult &step, Cell head, Cell tail, float alpha,
+                    Color bodyColor, Color headColor) const;
+    void DrawCellLerp(Cell from, Cell to, float alpha, float left, float top, Color color) const;
+
+    // 摄像机在一个方向上的起点 (格子坐标, 可以是小数)
+    float CameraStart(float center, int boardSize, int viewSize) const;
+
+    Texture2D cells;           // 可见区域每个格子一个像素, 比视口多一行一列用于滚动
+    std::vector<Color> pixels; // cells 在 CPU 端的副本
+    int viewWidth;
+    int viewHeight;
+    int textureWidth;
+    int textureHeight;
+    int cellSize;
+};
+
+template <class Sim>
+void ViewportRenderer::FillVisible(const Sim &sim, int originX, int originY)
+{
+    const auto &snake = sim.GetSnake();
+    const Food &food = sim.GetFood();
+    const Cell head = snake.Head().position;
+
+    for (int y = 0; y < textureHeight; y++)
+    {
+        Color *row = &pixels[(size_t)y * textureWidth];
+        for (int x = 0; x < textureWidth; x++)
+        {
+            Cell cell = {(int16_t)(originX + x), (int16_t)(originY + y)};
+            if (!sim.InBounds(cell))
+                row[x] = DARKGRAY; // 墙
+            else if (cell != head && snake.IsOccupied(cell))
+                row[x] = GREEN; // 蛇头单独插值绘制
+            else
+                row[x] = BLANK;
+        }
+    }
+
+    if (food.active)
+    {
+        int x = food.position.x - originX;
+        int y = food.position.y - originY;
+        if (x >= 0 && x < textureWidth && y >= 0 && y < textureHeight)
+            pixels[(size_t)y * textureWidth + x] = RED;
+    }
+}
+
+template <class Sim>
+void ViewportRenderer::Draw(const Sim &sim, const StepResult &lastStep, float alpha)
+{
+    const auto &snake = sim.GetSnake();
+    const Cell head = snake.Head().position;
+
+    // 摄像机中心跟随插值后的蛇头中心
+    float headX = lastStep.prevHead.x + (head.x - lastStep.prevHead.x) * alpha + 0.5f;
+    float headY = lastStep.prevHead.y + (head.y - lastStep.prevHead.y) * alpha + 0.5f;
+    float left = CameraStart(headX, sim.Width(), viewWidth);
+    float top = CameraStart(headY, sim.Height(), viewHeight);
+
+    int originX = (int)left;
+    int originY = (int)top;
+    FillVisible(sim, originX, originY);
+    UpdateTexture(cells, pixels.data());
+
+    PresentCells(left, top);
+    DrawMoving(left, top, lastStep, head, snake.Tail().position, alpha, GREEN, DARKGREEN);
+}
+
+template <class Board>
+void ViewportRenderer::FillVisibleOwners(const BasicMultiSimulation<Board> &sim, int originX, int originY)
+{
+    for (int y = 0; y < textureHeight; y++)
+    {
+        Color *row = &pixels[(size_t)y * textureWidth];
+        for (int x = 0; x < textureWidth; x++)
+        {
+            Cell cell = {(int16_t)(originX + x), (int16_t)(originY + y)};
+            if (!sim.InBounds(cell))
+            {
+                row[x] = DARKGRAY; // 墙
+                continue;
+            }
+            int player = sim.Owner(cell);
+            row[x] = (player < 0) ? BLANK : PlayerColor(player, false);
+        }
+    }
+
+    // 蛇头单独插值绘制
+    for (int p = 0; p < sim.PlayerCount(); p++)
+    {
+        if (sim.Alive(p))
+            ClearVisible(sim.GetSnake(p).Head().position, originX, originY);
+    }
+
+    const Food &food = sim.GetFood();
+    if (food.active)
+    {
+        int x = food.position.x - originX;
+        int y = food.position.y - originY;
+        if (x >= 0 && x < textureWidth && y >= 0 && y < textureHeight)
+            pixels[(size_t)y * textureWidth + x] = RED;
+    }
+}
+
+template <class Board>
+void ViewportRenderer::Draw(const BasicMultiSimulation<Board> &sim, const MultiStepResult &lastStep, float alpha)
+{
+    // 摄像机跟随第一条活着的蛇 (一屏放得下的棋盘上摄像机不动)
+    int followed = 0;
+    while (followed < sim.PlayerCount() - 1 && !sim.Alive(followed))
+        followed++;
+    const StepResult &followedStep = lastStep.players[followed];
+    const Cell followedHead = sim.GetSnake(followed).Head().position;
+
+    float headX = followedStep.prevHead.x + (followedHead.x - followedStep.prevHead.x) * alpha + 0.5f;
+    float headY = followedStep.prevHead.y + (followedHead.y - followedStep.prevHead.y) * alpha + 0.5f;
+    float left = CameraStart(headX, sim.Width(), viewWidth);
+    float top = CameraStart(headY, sim.Height(), viewHeight);
+
+    int originX = (int)left;
+    int originY = (int)top;
+    FillVisibleOwners(sim, originX, originY);
+    UpdateTexture(cells, pixels.data());
+
+    PresentCells(left, top);
+    for (int p = 0; p < sim.PlayerCount(); p++)
+    {
+        if (!sim.Alive(p))
+            continue; // 死掉的蛇已经从棋盘上移除
+        const auto &snake = sim.GetSnake(p);
+        DrawMoving(left, top, lastStep.players[p], snake.Head().position, snake.Tail().position, alpha,
+                   PlayerColor(p, false), PlayerColor(p, true));
+    }
+}
@@ -0,0 +1,180 @@
+"""Thin ctypes wrapper around the SnakeC batched simulation (SnakeC.h).
+
+All observation arrays are allocated once, in __init__, as contiguous NumPy
+arrays.  step() hands their data pointers to the library, which writes the
+new state straight into them, so nothing is copied or allocated per step.
+The arrays support the DLPack protocol (``torch.from_dlpack(env.grid)``) and
+are overwritten in place by every reset() / step().
+
+The shared library is looked up in $SNAKE_LIB, then next to this file.
+"""
+
+import ctypes
+import os
+import sys
+
+import numpy as np
+
+# ------------------------------------------------------------------------------------
+# Constants (SnakeC.h)
+# ------------------------------------------------------------------------------------
+CELL_EMPTY = 0
+CELL_BODY = 1
+CELL_HEAD = 2
+CELL_FOOD = 3
+
+RIGHT, LEFT, UP, DOWN = 0, 1, 2, 3
+
+# SnakeStepInfo, 12 bytes
+STEP_INFO_DTYPE = np.dtype(
+    [
+        ("reward", np.int8),
+        ("done", np.uint8),
+        ("won", np.uint8),
+        ("reserved", np.uint8),
+        ("episode_score", np.int32),
+        ("episode_ticks", np.uint32),
+    ]
+)
+
+
+class _Observation(ctypes.Structure):
+    _fields_ = [
+        ("grid", ctypes.c_void_p),
+        ("heads", ctypes.c_void_p),
+        ("foods", ctypes.c_void_p),
+        ("lengths", ctypes.c_void_p),
+    ]
+
+
+# ------------------------------------------------------------------------------------
+# Library Loading
+# ------------------------------------------------------------------------------------
+def _library_names():
+    if sys.platform == "win32":
+        return ["snake_c.dll"]
+    if sys.platform == "darwin":
+        return ["libsnake_c.dylib"]
+    return ["libsnake_c.so"]
+
+
+def _load_library():
+    path = os.environ.get("SNAKE_LIB")
+    if path:
+        return ctypes.CDLL(path)
+
+    here = os.path.dirname(os.path.abspath(__file__))
+    for name in _library_names():
+        candidate = os.path.join(here, name)
+        if os.path.exists(candidate):
+            return ctypes.CDLL(candidate)
+    raise OSError("cannot find the SnakeC library; set SNAKE_LIB to its path")
+
+
+_lib = _load_library()
+
+_lib.SnakeVersion.restype = ctypes.c_int
+_lib.SnakeEnvCreate.restype = ctypes.c_void_p
+_lib.SnakeEnvCreate.argtypes = [ctypes.c_int32, ctypes.c_int32, ctypes.c_int32, ctypes.c_uint32, ctypes.c_int32]
+_lib.SnakeEnvDestroy.argtypes = [ctypes.c_void_p]
+_lib.SnakeEnvReset.argtypes = [ctypes.c_void_p, ctypes.POINTER(_Observation)]
+_lib.SnakeEnvStep.restype = ctypes.c_int
+_lib.SnakeEnvStep.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.POINTER(_Observation)]
+_lib.SnakeEnvObserve.argtypes = [ctypes.c_void_p, ctypes.POINTER(_Observation)]
+
+if _lib.SnakeVersion() != 1:
+    raise OSError("unsupported SnakeC version %d" % _lib.SnakeVersion())
+
+
+# ------------------------------------------------------------------------------------
+# Batched Environment
+# ------------------------------------------------------------------------------------
+class SnakeBatchEnv:
+    """count games stepped in lock-step; finished games reset in place.
+
+    Attributes (views that are rewritten by every reset/step):
+        grid     uint8 [count, height, width], CELL_* values
+        heads    int16 [count, 2] (x, y)
+        foods    int16 [count, 2] (x, y), (-1, -1) when there is no food
+        lengths  int32 [count]
+        infos    STEP_INFO_DTYPE [count]; rewards/dones/... are field views
+    """
+
+    _handle = None  # close() / __del__ still work when __init__ raised before creating the env
+
+    def __init__(self, count, width=40, height=30, seed=1, threads=0):
+        handle = _lib.SnakeEnvCreate(count, width, height, seed, threads)
+        if not handle:
+            raise ValueError("invalid environment parameters (each side at most 4096) or out of memory")
+        self._handle = handle
+        self.count = count
+        self.width = width
+        self.height = height
+
+        self.grid = np.zeros((count, height, width), dtype=np.uint8)
+        self.heads = np.zeros((count, 2), dtype=np.int16)
+        self.foods = np.zeros((count, 2), dtype=np.int16)
+        self.lengths = np.zeros(count, dtype=np.int32)
+        self.infos = np.zeros(count, dtype=STEP_INFO_DTYPE)
+        self.rewards = self.infos["reward"]
+        self.dones = self.infos["done"]
+        self.episode_scores = self.infos["episode_score"]
+
+        # The pointers never change, so the observation struct is built only once
+        self._observation = _Observation(
+            self.grid.ctypes.data, self.heads.ctypes.data, self.foods.ctypes.data, self.lengths.ctypes.data
+        )
+        self._observation_ref = ctypes.byref(self._observation)
+        self._infos_ptr = self.infos.ctypes.data
+
+    def close(self):
+        if self._handle:
+            _lib.SnakeEnvDestroy(self._handle)
+            self._handle = None
+
+    def __del__(self):
+        self.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def reset(self):
+        _lib.SnakeEnvReset(self._handle, self._observation_ref)
+        return self.grid
+
+    def step(self, actions):
+        """actions: int32 array [count], values 0..3 (RIGHT, LEFT, UP, DOWN).
+
+        Pass a C-contiguous int32 array to avoid a conversion copy here.
+        Returns (grid, rewards, dones), all views into the preallocated arrays.
+        """
+        if not (isinstance(actions, np.ndarray) and actions.dtype == np.int32 and actions.flags.c_contiguous):
+            actions = np.ascontiguousarray(actions, dtype=np.int32)
+        if actions.shape != (self.count,):
+            raise ValueError("expected %d actions" % self.count)
+
+        _lib.SnakeEnvStep(self._handle, actions.ctypes.data, self._infos_ptr, self._observation_ref)
+        return self.grid, self.rewards, self.dones
+
+    def observe(self):
+        _lib.SnakeEnvObserve(self._handle, self._observation_ref)
+        return self.grid
+
+
+if __name__ == "__main__":
+    import time
+
+    env = SnakeBatchEnv(4096)
+    env.reset()
+    rng = np.random.default_rng(0)
+    actions = rng.integers(0, 4, size=env.count, dtype=np.int32)
+    steps = 200
+    start = time.perf_counter()
+    for _ in range(steps):
+        env.step(actions)
+    elapsed = time.perf_counter() - start
+    print("%.0f game steps/s" % (steps * env.count / elapsed))
+    env.close()
@@ -0,0 +1,231 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const char PACK_MAGIC[4] = {'S', 'P', 'A', 'K'};
+static const uint8_t PACK_VERSION = 1;
+static const size_t HEADER_SIZE = 4 + 1 + 3 + 4;
+static const size_t ENTRY_SIZE = ASSET_NAME_SIZE + 8 + 8;
+
+static void PutLittle(uint8_t *out, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint64_t GetLittle(const uint8_t *in, int bytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++)
+    {
+        value |= (uint64_t)in[i] << (8 * i);
+    }
+    return value;
+}
+
+// ------------------------------------------------------------------------------------
+// Reading
+// ------------------------------------------------------------------------------------
+AssetPack::AssetPack(void) : base(nullptr), size(0), entries()
+#if defined(_WIN32)
+                             , file(nullptr), mapping(nullptr)
+#endif
+{
+}
+
+bool AssetPack::Open(const char *fileName)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER length;
+    HANDLE view = nullptr;
+    if (GetFileSizeEx(handle, &length) && length.QuadPart > 0)
+        view = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (view == nullptr)
+    {
+        CloseHandle(handle);
+        return false;
+    }
+    file = handle;
+    mapping = view;
+    size = (size_t)length.QuadPart;
+    base = (const uint8_t *)MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    void *view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+        view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // 映射在关闭文件之后仍然有效
+    if (view == MAP_FAILED)
+        return false;
+    size = (size_t)info.st_size;
+    base = (const uint8_t *)view;
+#endif
+    if (base == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    // 校验文件头和索引: 每个数据块都必须在文件里, 名字必须以 0 结尾并且严格递增 (Find 要二分)
+    bool ok = size >= HEADER_SIZE && memcmp(base, PACK_MAGIC, 4) == 0 && base[4] == PACK_VERSION;
+    const uint64_t count = ok ? GetLittle(base + 8, 4) : 0;
+    ok = ok && count <= (size - HEADER_SIZE) / ENTRY_SIZE;
+    if (ok)
+        entries.resize((size_t)count);
+    for (size_t i = 0; ok && i < entries.size(); i++)
+    {
+        const uint8_t *in = base + HEADER_SIZE + i * ENTRY_SIZE;
+        const uint64_t offset = GetLittle(in + ASSET_NAME_SIZE, 8);
+        const uint64_t length = GetLittle(in + ASSET_NAME_SIZE + 8, 8);
+
+        Entry &entry = entries[i];
+        memcpy(entry.name, in, ASSET_NAME_SIZE);
+        entry.blob.data = base + offset;
+        entry.blob.size = (size_t)length;
+        ok = entry.name[ASSET_NAME_SIZE - 1] == '\0' && offset <= size && length <= size - offset &&
+             (i == 0 || strcmp(entries[i - 1].name, entry.name) < 0);
+    }
+
+    if (!ok)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::Close(void)
+{
+    entries.clear();
+#if defined(_WIN32)
+    if (base != nullptr)
+        UnmapViewOfFile(base);
+    if (mapping != nullptr)
+        CloseHandle((HANDLE)mapping);
+    if (file != nullptr)
+        CloseHandle((HANDLE)file);
+    mapping = nullptr;
+    file = nullptr;
+#else
+    if (base != nullptr)
+        munmap((void *)base, size);
+#endif
+    base = nullptr;
+    size = 0;
+}
+
+bool AssetPack::Find(const char *name, AssetBlob &blob) const
+{
+    auto found = std::lower_bound(entries.begin(), entries.end(), name,
+                                  [](const Entry &entry, const char *key) { return strcmp(entry.name, key) < 0; });
+    if (found == entries.end() || strcmp(found->name, name) != 0)
+        return false;
+
+    blob = found->blob;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------
+// Writing
+// ------------------------------------------------------------------------------------
+static bool ReadWholeFile(const char *fileName, std::vector<uint8_t> &data)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (file == nullptr)
+        return false;
+
+    bool ok = fseek(file, 0, SEEK_END) == 0;
+    long length = ok ? ftell(file) : -1;
+    ok = length >= 0 && fseek(file, 0, SEEK_SET) == 0;
+    if (ok)
+    {
+        data.resize((size_t)length);
+        ok = data.empty() || fread(data.data(), 1, data.size(), file) == data.size();
+    }
+    fclose(file);
+    return ok;
+}
+
+bool WriteAssetPack(const char *fileName, const std::vector<AssetSource> &sources)
+{
+    std::vector<AssetSource> sorted = sources;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const AssetSource &a, const AssetSource &b) { return a.name < b.name; });
+
+    std::vector<uint8_t> index(HEADER_SIZE + sorted.size() * ENTRY_SIZE, 0);
+    memcpy(index.data(), PACK_MAGIC, 4);
+    index[4] = PACK_VERSION;
+    PutLittle(index.data() + 8, (uint64_t)sorted.size(), 4);
+
+    // 先读所有文件, 算出每块的偏移, 再一次写出索引和数据
+    std::vector<std::vector<uint8_t>> blobs(sorted.size());
+    uint64_t offset = (index.size() + ASSET_ALIGNMENT - 1) / ASSET_ALIGNMENT * ASSET_ALIGNMENT;
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        const AssetSource &source = sorted[i];
+        if (source.name.empty() || source.name.size() >= ASSET_NAME_SIZE ||
+            (i > 0 && source.name == sorted[i - 1].name))
+        {
+            fprintf(stderr, "invalid or duplicate asset name \"%s\"\n", source.name.c_str());
+            return false;
+        }
+        if (!ReadWholeFile(source.path.c_str(), blobs[i]))
+        {
+            fprintf(stderr, "cannot read %s\n", source.path.c_str());
+            return false;
+        }
+
+        uint8_t *out = index.data() + HEADER_SIZE + i * ENTRY_SIZE;
+        memcpy(out, source.name.c_str(), source.name.size());
+        PutLittle(out + ASSET_NAME_SIZE, offset, 8);
+        PutLittle(out + ASSET_NAME_SIZE + 8, (uint64_t)blobs[i].size(), 8);
+        offset = (offset + blobs[i].size() + ASSET_ALIGNMENT - 1) / ASSET_ALIGNMENT * ASSET_ALIGNMENT;
+    }
+
+    FILE *file = fopen(fileName, "wb");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "cannot create %s\n", fileName);
+        return false;
+    }
+
+    static const uint8_t padding[ASSET_ALIGNMENT] = {};
+    bool ok = fwrite(index.data(), 1, index.size(), file) == index.size();
+    uint64_t written = index.size();
+    for (size_t i = 0; ok && i < blobs.size(); i++)
+    {
+        size_t pad = (size_t)((ASSET_ALIGNMENT - written % ASSET_ALIGNMENT) % ASSET_ALIGNMENT);
+        ok = fwrite(padding, 1, pad, file) == pad &&
+             (blobs[i].empty() || fwrite(blobs[i].data(), 1, blobs[i].size(), file) == blobs[i].size());
+        written += pad + blobs[i].size();
+    }
+    ok = (fclose(file) == 0) && ok;
+    if (!ok)
+        fprintf(stderr, "cannot write %s\n", fileName);
+    return ok;
+}
@@ -0,0 +1,147 @@
+#include "Audio.h"
+#include "AssetPack.h"
+#include "raylib.h"
+#include <string>
+#include <thread>
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const int SOUND_ALIAS_COUNT = 4; // 每个音效最多同时播放的次数
+
+static const char *const SOUND_FILES[SOUND_COUNT] = {
+    "eat.wav",
+    "gameover.wav",
+};
+
+struct SoundSlot
+{
+    Sound source;                     // 真正持有音频数据的 Sound
+    Sound aliases[SOUND_ALIAS_COUNT]; // 共享 source 数据的别名, aliases[0] 就是 source 本身
+    int next;                         // 下一个轮询使用的别名
+    bool ready;
+};
+
+// ------------------------------------------------------------------------------------
+// Module Variables
+// ------------------------------------------------------------------------------------
+static SoundSlot sounds[SOUND_COUNT];
+static bool soundsEnabled = true;
+
+static std::thread preloadThread;
+static bool preloadStarted = false;
+static Wave decodedWaves[SOUND_COUNT]; // 预加载线程写入, join 之后主线程读取
+
+// ------------------------------------------------------------------------------------
+// Module Internal Functions
+// ------------------------------------------------------------------------------------
+static Wave LoadLooseWave(const std::string &directory, const char *name)
+{
+    std::string path = directory + "resources/" + name;
+    if (FileExists(path.c_str()))
+        return LoadWave(path.c_str());
+    path = std::string("resources/") + name; // 旧的相对当前目录的位置
+    return FileExists(path.c_str()) ? LoadWave(path.c_str()) : Wave{};
+}
+
+// 在预加载线程上运行: 第一次访问映射的页面时才真正读盘, 解码后的 Wave 是一份拷贝,
+// 所以解码完就可以解除映射
+static void DecodeSounds(std::string directory)
+{
+    AssetPack pack;
+    bool packed = pack.Open((directory + ASSET_PACK_FILE).c_str());
+    for (int i = 0; i < SOUND_COUNT; i++)
+    {
+        AssetBlob blob;
+        if (packed && pack.Find(SOUND_FILES[i], blob))
+            decodedWaves[i] = LoadWaveFromMemory(GetFileExtension(SOUND_FILES[i]), blob.data, (int)blob.size);
+        else
+            decodedWaves[i] = LoadLooseWave(directory, SOUND_FILES[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Module Functions Implementation
+// ------------------------------------------------------------------------------------
+void StartGameSoundPreload(void)
+{
+    if (preloadStarted)
+        return;
+
+    // GetApplicationDirectory 返回一个静态缓冲区, 在主线程上复制一份交给预加载线程
+    preloadThread = std::thread(DecodeSounds, std::string(GetApplicationDirectory()));
+    preloadStarted = true;
+}
+
+void LoadGameSounds(void)
+{
+    StartGameSoundPreload(); // 没有提前启动时这里同步等它
+    preloadThread.join();
+    preloadStarted = false;
+
+    for (int i = 0; i < SOUND_COUNT; i++)
+    {
+        SoundSlot &slot = sounds[i];
+        slot.ready = false;
+        if (IsWaveReady(decodedWaves[i]))
+        {
+            // 只是把解码好的采样复制进混音器的缓冲区, 不读盘
+            slot.source = LoadSoundFromWave(decodedWaves[i]);
+            slot.ready = IsSoundReady(slot.source);
+            UnloadWave(decodedWaves[i]);
+        }
+        decodedWaves[i] = Wave{};
+        slot.next = 0;
+        if (!slot.ready)
+            continue; // 缺少音效文件时静默跳过
+
+        slot.aliases[0] = slot.source;
+        for (int j = 1; j < SOUND_ALIAS_COUNT; j++)
+        {
+            slot.aliases[j] = LoadSoundAlias(slot.source);
+        }
+    }
+}
+
+void UnloadGameSounds(void)
+{
+    for (int i = 0; i < SOUND_COUNT; i++)
+    {
+        SoundSlot &slot = sounds[i];
+        if (!slot.ready)
+            continue;
+
+        // 先卸载别名, 再卸载持有数据的 source
+        for (int j = 1; j < SOUND_ALIAS_COUNT; j++)
+        {
+            UnloadSoundAlias(slot.aliases[j]);
+        }
+        UnloadSound(slot.source);
+        slot.ready = false;
+    }
+}
+
+void PlayGameSound(SoundId sound)
+{
+    SoundSlot &slot = sounds[sound];
+    if (!slot.ready || !soundsEnabled)
+        return;
+
+    // 优先找一个空闲的别名; 全都在播放时轮询覆盖最早的那个
+    for (int j = 0; j < SOUND_ALIAS_COUNT; j++)
+    {
+        int index = (slot.next + j) % SOUND_ALIAS_COUNT;
+        if (!IsSoundPlaying(slot.aliases[index]))
+        {
+            slot.next = index;
+            break;
+        }
+    }
+    PlaySound(slot.aliases[slot.next]);
+    slot.next = (slot.next + 1) % SOUND_ALIAS_COUNT;
+}
+
+void SetGameSoundsEnabled(bool enabled)
+{
+    soundsEnabled = enabled;
+}
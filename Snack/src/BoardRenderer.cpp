@@ -0,0 +1,115 @@
+#include "BoardRenderer.h"
+
+BoardRenderer::BoardRenderer(void)
+    : board{}, cells{}, width(0), height(0), cellSize(0), fullRebuild(true)
+{
+}
+
+void BoardRenderer::Load(int newWidth, int newHeight, int newCellSize)
+{
+    width = newWidth;
+    height = newHeight;
+    cellSize = newCellSize;
+
+    board = LoadRenderTexture(width * cellSize, height * cellSize);
+
+    pixels.assign((size_t)width * height, BLANK);
+    Image image = GenImageColor(width, height, BLANK);
+    cells = LoadTextureFromImage(image);
+    UnloadImage(image);
+    SetTextureFilter(cells, TEXTURE_FILTER_POINT); // 放大时保持格子边缘锐利
+
+    dirty.reserve(MAX_DIRTY_CELLS);
+    fullRebuild = true;
+}
+
+void BoardRenderer::Unload(void)
+{
+    UnloadTexture(cells);
+    UnloadRenderTexture(board);
+}
+
+void BoardRenderer::MarkDirty(Cell position, Color color)
+{
+    pixels[(size_t)position.y * width + position.x] = color;
+    dirty.push_back({position, color});
+}
+
+// 重画一个格子: 先恢复背景和它左边, 上边的网格线, 再填上颜色
+void BoardRenderer::PaintCell(Cell position, Color color) const
+{
+    const int x = position.x * cellSize;
+    const int y = position.y * cellSize;
+    DrawRectangle(x, y, cellSize, cellSize, RAYWHITE);
+    DrawLine(x, y, x, y + cellSize, LIGHTGRAY);
+    DrawLine(x, y, x + cellSize, y, LIGHTGRAY);
+    if (color.a != 0)
+    {
+        DrawRectangle(x, y, cellSize, cellSize, color);
+    }
+}
+
+// 用 pixels 完整重建棋盘画面
+void BoardRenderer::Rebuild(void)
+{
+    const int pixelWidth = width * cellSize;
+    const int pixelHeight = height * cellSize;
+
+    UpdateTexture(cells, pixels.data());
+
+    BeginTextureMode(board);
+    ClearBackground(RAYWHITE);
+    // 绘制网格线 (可选)
+    for (int i = 0; i < width; i++)
+    {
+        DrawLine(i * cellSize, 0, i * cellSize, pixelHeight, LIGHTGRAY);
+    }
+    for (int i = 0; i < height; i++)
+    {
+        DrawLine(0, i * cellSize, pixelWidth, i * cellSize, LIGHTGRAY);
+    }
+    DrawTexturePro(cells, {0, 0, (float)width, (float)height}, {0, 0, (float)pixelWidth, (float)pixelHeight}, {0, 0}, 0.0f, WHITE);
+    EndTextureMode();
+
+    dirty.clear();
+    fullRebuild = false;
+}
+
+void BoardRenderer::Flush(void)
+{
+    if (dirty.empty())
+        return; // 两个 tick 之间棋盘没有变化, 什么都不用画
+
+    BeginTextureMode(board);
+    for (const DirtyCell &cell : dirty)
+    {
+        PaintCell(cell.position, cell.color);
+    }
+    EndTextureMode();
+    dirty.clear();
+}
+
+// 在两个格子之间按 alpha 插值绘制
+void BoardRenderer::DrawCellLerp(Cell from, Cell to, float alpha, Color color) const
+{
+    Vector2 pixel = {
+        (from.x + (to.x - from.x) * alpha) * cellSize,
+        (from.y + (to.y - from.y) * alpha) * cellSize};
+    DrawRectangleV(pixel, {(float)cellSize, (float)cellSize}, color);
+}
+
+void BoardRenderer::DrawMoving(const StepResult &lastStep, Cell head, Cell tail, float alpha) const
+{
+    const float pixelWidth = (float)(width * cellSize);
+    const float pixelHeight = (float)(height * cellSize);
+
+    // RenderTexture 的纹理是上下颠倒的, 源矩形高度取负
+    DrawTextureRec(board.texture, {0, 0, pixelWidth, -pixelHeight}, {0, 0}, WHITE);
+
+    // 身体画在当前 tick 的位置上, 蛇头和刚移走的蛇尾在两个 tick 之间插值
+    if (lastStep.tailMoved)
+    {
+        DrawCellLerp(lastStep.prevTail, tail, alpha, GREEN);
+    }
+    DrawCellLerp(lastStep.prevHead, head, alpha, DARKGREEN); // 蛇头用深绿色
+}
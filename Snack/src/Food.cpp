@@ -0,0 +1,5 @@
+#include "Food.h"
+
+// 常用棋盘的显式实例化, 其它 FixedBoard 在使用处按需实例化
+template class BasicFoodSpawner<DynamicBoard>;
+template class BasicFoodSpawner<ClassicBoard>;
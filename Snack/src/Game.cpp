@@ -0,0 +1,123 @@
+#include "Game.h"
+#include "Audio.h"
+#include "Constants.h"
+#include "Profiler.h"
+#include "raylib.h"
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const char *const STATS_FILE = "snake_stats.log"; // 只追加的战绩日志, 和录像一样放在当前目录
+
+Game::Game(void)
+    : screens{}, stack{}, depth(0), options{true, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, SPEED_CLASSIC}, running(false), lastScore(0), lastWon(false), lastVersus(false), lastWinner(-1), lastRank(-1)
+{
+    screens[SCREEN_MENU] = &menuScreen;
+    screens[SCREEN_OPTIONS] = &optionScreen;
+    screens[SCREEN_PLAY] = &playScreen;
+    screens[SCREEN_VERSUS] = &versusScreen;
+    screens[SCREEN_ONLINE] = &onlineScreen;
+    screens[SCREEN_GAME_OVER] = &gameOverScreen;
+}
+
+void Game::Run(void)
+{
+    StartGameSoundPreload(); // 资源包的读盘和解码和下面创建窗口, 加载画面资源同时进行
+    stats.Open(STATS_FILE);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Simple Raylib Snake");
+    InitAudioDevice();
+    SetTargetFPS(60);
+    SetExitKey(KEY_NULL); // ESC 由各个画面自己处理
+
+    // 所有画面的资源在这里一次性加载, 切换画面时不再加载
+    for (Screen *screen : screens)
+    {
+        screen->Load();
+    }
+    LoadGameSounds(); // 等预加载结束, 音效只加载一次; 菜单出现之前全部就绪
+
+    running = true;
+    PushScreen(SCREEN_MENU);
+
+    while (running && !WindowShouldClose())
+    {
+        SNAKE_PROFILE_SCOPE(PROFILE_FRAME);
+        UpdateProfilerOverlay(); // F3 / F4, 没有编译进性能分析时什么都不做
+        {
+            SNAKE_PROFILE_SCOPE(PROFILE_UPDATE);
+            Top()->Update(*this, GetFrameTime());
+        }
+
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        {
+            SNAKE_PROFILE_SCOPE(PROFILE_DRAW);
+            Top()->Draw(*this);
+        }
+        DrawProfilerOverlay();
+        EndDrawing();
+        SNAKE_PROFILE_FRAME_END();
+    }
+
+    while (depth > 0)
+    {
+        PopScreen();
+    }
+    for (Screen *screen : screens)
+    {
+        screen->Unload();
+    }
+
+    stats.Close(); // 写完还在排队的战绩
+    UnloadGameSounds();
+    CloseAudioDevice();
+    CloseWindow();
+}
+
+void Game::ChangeScreen(ScreenId id)
+{
+    if (depth > 0)
+    {
+        Top()->Exit(*this);
+        depth--;
+    }
+    PushScreen(id);
+}
+
+void Game::PushScreen(ScreenId id)
+{
+    if (depth == MAX_SCREEN_DEPTH)
+        return;
+
+    stack[depth++] = screens[id];
+    Top()->Enter(*this);
+}
+
+void Game::PopScreen(void)
+{
+    if (depth == 0)
+        return;
+
+    Top()->Exit(*this);
+    depth--;
+    if (depth == 0)
+        running = false; // 没有画面了就退出
+}
+
+void Game::SetLastResult(int score, bool won, int rank)
+{
+    lastScore = score;
+    lastWon = won;
+    lastVersus = false;
+    lastWinner = -1;
+    lastRank = rank;
+}
+
+void Game::SetLastVersusResult(int winner, int winnerScore)
+{
+    lastScore = winnerScore;
+    lastWon = winner >= 0;
+    lastVersus = true;
+    lastWinner = winner;
+    lastRank = -1;
+}
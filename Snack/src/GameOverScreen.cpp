@@ -0,0 +1,115 @@
+#include "GameOverScreen.h"
+#include "Constants.h"
+#include "Game.h"
+#include <cstdio>
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const int ROW_FONT_SIZE = 20;
+static const int ROW_HEIGHT = 24;
+
+GameOverScreen::GameOverScreen(void)
+    : gameOverLabel("GAME OVER", 40, RED),
+      winLabel("YOU WIN!", 40, DARKGREEN),
+      playerWinLabels{
+          {"PLAYER 1 WINS!", 40, DARKGREEN},
+          {"PLAYER 2 WINS!", 40, DARKBLUE}},
+      drawLabel("DRAW", 40, DARKGRAY),
+      restartLabel("Press [ENTER] to play again", 20, GRAY),
+      scoreText("Your Score: %i", 20),
+      leaderboardLabel("BEST SCORES", 20, DARKGREEN),
+      rowTexts{}, rowWidths{}, rowCount(0), totalsText{}, totalsWidth(0)
+{
+}
+
+void GameOverScreen::Load(void)
+{
+    gameOverLabel.Load();
+    winLabel.Load();
+    for (StaticLabel &label : playerWinLabels)
+    {
+        label.Load();
+    }
+    drawLabel.Load();
+    restartLabel.Load();
+    leaderboardLabel.Load();
+}
+
+void GameOverScreen::Unload(void)
+{
+    gameOverLabel.Unload();
+    winLabel.Unload();
+    for (StaticLabel &label : playerWinLabels)
+    {
+        label.Unload();
+    }
+    drawLabel.Unload();
+    restartLabel.Unload();
+    leaderboardLabel.Unload();
+}
+
+void GameOverScreen::Enter(Game &game)
+{
+    const StatsStore &stats = game.Stats();
+    rowCount = stats.LeaderboardCount();
+    for (int i = 0; i < rowCount; i++)
+    {
+        const GameRecord &record = stats.Leaderboard(i);
+        unsigned seconds = record.durationMillis / 1000;
+        snprintf(rowTexts[i], sizeof(rowTexts[i]), "%d.  %5d   length %u   %u:%02u", i + 1, (int)record.score,
+                 (unsigned)record.length, seconds / 60, seconds % 60);
+        rowWidths[i] = MeasureText(rowTexts[i], ROW_FONT_SIZE);
+    }
+
+    unsigned long long minutes = (unsigned long long)(stats.TotalMillis() / 60000);
+    snprintf(totalsText, sizeof(totalsText), "%llu games, %llu min played, longest snake %u",
+             (unsigned long long)stats.GamesPlayed(), minutes, (unsigned)stats.BestLength());
+    totalsWidth = MeasureText(totalsText, ROW_FONT_SIZE);
+}
+
+void GameOverScreen::Update(Game &game, float)
+{
+    if (IsKeyPressed(KEY_ENTER))
+    {
+        game.ChangeScreen(game.LastVersus() ? SCREEN_VERSUS : SCREEN_PLAY); // 按回车重新开始, 画面只是重置状态
+    }
+    else if (IsKeyPressed(KEY_ESCAPE))
+    {
+        game.ChangeScreen(SCREEN_MENU);
+    }
+}
+
+void GameOverScreen::Draw(const Game &game)
+{
+    const int centerX = SCREEN_WIDTH / 2;
+    const int centerY = SCREEN_HEIGHT / 2;
+
+    const StaticLabel *title = game.LastWon() ? &winLabel : &gameOverLabel;
+    if (game.LastVersus())
+        title = (game.LastWinner() >= 0) ? &playerWinLabels[game.LastWinner()] : &drawLabel;
+
+    // 单人模式下标题和分数往上挪, 给排行榜留出位置
+    const int top = game.LastVersus() ? centerY - 40 : SCREEN_HEIGHT / 6;
+    title->DrawCentered(centerX, top);
+
+    scoreText.Set(game.LastScore());
+    scoreText.DrawCentered(centerX, top + 50, DARKGRAY);
+
+    restartLabel.DrawCentered(centerX, top + 80);
+
+    if (game.LastVersus())
+        return;
+
+    int y = top + 140;
+    leaderboardLabel.DrawCentered(centerX, y);
+    y += ROW_HEIGHT + 8;
+    for (int i = 0; i < rowCount; i++)
+    {
+        // 刚结束的这一局进了榜时高亮
+        Color color = (i == game.LastRank()) ? RED : DARKGRAY;
+        DrawText(rowTexts[i], centerX - rowWidths[i] / 2, y, ROW_FONT_SIZE, color);
+        y += ROW_HEIGHT;
+    }
+    DrawText(totalsText, centerX - totalsWidth / 2, y + 16, ROW_FONT_SIZE, GRAY);
+}
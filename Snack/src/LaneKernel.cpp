@@ -0,0 +1,185 @@
+#include "LaneKernel.h"
+
+// 向量版本把 actions 当作 int32 数组读取
+static_assert(sizeof(SnakeDirection) == sizeof(int32_t), "SnakeDirection must be 32-bit");
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SNAKE_LANES_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#define SNAKE_LANES_NEON 1
+#include <arm_neon.h>
+#endif
+
+// ------------------------------------------------------------------------------------
+// Scalar
+// ------------------------------------------------------------------------------------
+void StepLanesScalar(const LaneState &state, const SnakeDirection *actions, const LaneResult &result,
+                     int begin, int end, int width, int height)
+{
+    for (int i = begin; i < end; i++)
+    {
+        SnakeDirection current = (SnakeDirection)state.direction[i];
+        SnakeDirection dir = IsOpposite(actions[i], current) ? current : actions[i];
+        Cell next = MoveCell({state.headX[i], state.headY[i]}, dir);
+
+        state.direction[i] = (int16_t)dir;
+        result.nextX[i] = next.x;
+        result.nextY[i] = next.y;
+        result.hitWall[i] = (unsigned)next.x >= (unsigned)width || (unsigned)next.y >= (unsigned)height;
+        result.ateFood[i] = next.x == state.foodX[i] && next.y == state.foodY[i];
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// AVX2: 16 局 / 指令
+// ------------------------------------------------------------------------------------
+#ifdef SNAKE_LANES_AVX2
+__attribute__((target("avx2"))) static void StepLanesAvx2(const LaneState &state, const SnakeDirection *actions,
+                                                          const LaneResult &result, int begin, int end,
+                                                          int width, int height)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i two = _mm256_set1_epi16(2);
+    const __m256i three = _mm256_set1_epi16(3);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i maxX = _mm256_set1_epi16((int16_t)(width - 1));
+    const __m256i maxY = _mm256_set1_epi16((int16_t)(height - 1));
+
+    int i = begin;
+    for (; i + 16 <= end; i += 16)
+    {
+        // 两组 8 个 int32 输入压成 16 个 int16; packs 按 128 位分半处理, 再把中间两块换回来
+        __m256i actionLo = _mm256_loadu_si256((const __m256i *)(actions + i));
+        __m256i actionHi = _mm256_loadu_si256((const __m256i *)(actions + i + 8));
+        __m256i action = _mm256_permute4x64_epi64(_mm256_packs_epi32(actionLo, actionHi), 0xd8);
+
+        __m256i current = _mm256_loadu_si256((const __m256i *)(state.direction + i));
+        __m256i opposite = _mm256_cmpeq_epi16(_mm256_xor_si256(action, one), current);
+        __m256i dir = _mm256_blendv_epi8(action, current, opposite);
+
+        // dx = (dir == RIGHT) - (dir == LEFT), dy = (dir == DOWN) - (dir == UP); 比较结果是 0 / -1
+        __m256i dx = _mm256_sub_epi16(_mm256_cmpeq_epi16(dir, one), _mm256_cmpeq_epi16(dir, zero));
+        __m256i dy = _mm256_sub_epi16(_mm256_cmpeq_epi16(dir, two), _mm256_cmpeq_epi16(dir, three));
+
+        __m256i x = _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)(state.headX + i)), dx);
+        __m256i y = _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)(state.headY + i)), dy);
+
+        __m256i wall = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi16(zero, x), _mm256_cmpgt_epi16(x, maxX)),
+                                       _mm256_or_si256(_mm256_cmpgt_epi16(zero, y), _mm256_cmpgt_epi16(y, maxY)));
+        __m256i food = _mm256_and_si256(_mm256_cmpeq_epi16(x, _mm256_loadu_si256((const __m256i *)(state.foodX + i))),
+                                        _mm256_cmpeq_epi16(y, _mm256_loadu_si256((const __m256i *)(state.foodY + i))));
+
+        _mm256_storeu_si256((__m256i *)(state.direction + i), dir);
+        _mm256_storeu_si256((__m256i *)(result.nextX + i), x);
+        _mm256_storeu_si256((__m256i *)(result.nextY + i), y);
+        _mm256_storeu_si256((__m256i *)(result.hitWall + i), _mm256_and_si256(wall, one));
+        _mm256_storeu_si256((__m256i *)(result.ateFood + i), _mm256_and_si256(food, one));
+    }
+    StepLanesScalar(state, actions, result, i, end, width, height);
+}
+#endif
+
+// ------------------------------------------------------------------------------------
+// NEON: 8 局 / 指令
+// ------------------------------------------------------------------------------------
+#ifdef SNAKE_LANES_NEON
+static void StepLanesNeon(const LaneState &state, const SnakeDirection *actions, const LaneResult &result,
+                          int begin, int end, int width, int height)
+{
+    const int16x8_t one = vdupq_n_s16(1);
+    const int16x8_t zero = vdupq_n_s16(0);
+    const int16x8_t maxX = vdupq_n_s16((int16_t)(width - 1));
+    const int16x8_t maxY = vdupq_n_s16((int16_t)(height - 1));
+
+    int i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        int32x4_t actionLo = vld1q_s32((const int32_t *)(actions + i));
+        int32x4_t actionHi = vld1q_s32((const int32_t *)(actions + i + 4));
+        int16x8_t action = vcombine_s16(vmovn_s32(actionLo), vmovn_s32(actionHi));
+
+        int16x8_t current = vld1q_s16(state.direction + i);
+        uint16x8_t opposite = vceqq_s16(veorq_s16(action, one), current);
+        int16x8_t dir = vbslq_s16(opposite, current, action);
+
+        // 比较结果是 0 / 0xffff, 当作 int16 就是 0 / -1
+        int16x8_t dx = vsubq_s16(vreinterpretq_s16_u16(vceqq_s16(dir, one)),
+                                 vreinterpretq_s16_u16(vceqq_s16(dir, zero)));
+        int16x8_t dy = vsubq_s16(vreinterpretq_s16_u16(vceqq_s16(dir, vdupq_n_s16(2))),
+                                 vreinterpretq_s16_u16(vceqq_s16(dir, vdupq_n_s16(3))));
+
+        int16x8_t x = vaddq_s16(vld1q_s16(state.headX + i), dx);
+        int16x8_t y = vaddq_s16(vld1q_s16(state.headY + i), dy);
+
+        uint16x8_t wall = vorrq_u16(vorrq_u16(vcltq_s16(x, zero), vcgtq_s16(x, maxX)),
+                                    vorrq_u16(vcltq_s16(y, zero), vcgtq_s16(y, maxY)));
+        uint16x8_t food = vandq_u16(vceqq_s16(x, vld1q_s16(state.foodX + i)), vceqq_s16(y, vld1q_s16(state.foodY + i)));
+
+        vst1q_s16(state.direction + i, dir);
+        vst1q_s16(result.nextX + i, x);
+        vst1q_s16(result.nextY + i, y);
+        vst1q_s16(result.hitWall + i, vandq_s16(vreinterpretq_s16_u16(wall), one));
+        vst1q_s16(result.ateFood + i, vandq_s16(vreinterpretq_s16_u16(food), one));
+    }
+    StepLanesScalar(state, actions, result, i, end, width, height);
+}
+#endif
+
+// ------------------------------------------------------------------------------------
+// Dispatch
+// ------------------------------------------------------------------------------------
+static LaneKernel DetectLaneKernel(const char **name)
+{
+#ifdef SNAKE_LANES_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        *name = "avx2";
+        return StepLanesAvx2;
+    }
+#endif
+#ifdef SNAKE_LANES_NEON
+    *name = "neon"; // AArch64 上 NEON 总是可用
+    return StepLanesNeon;
+#endif
+    *name = "scalar";
+    return StepLanesScalar;
+}
+
+static const char *laneKernelName = "scalar";
+
+LaneKernel SelectLaneKernel(void)
+{
+    static const LaneKernel kernel = DetectLaneKernel(&laneKernelName);
+    return kernel;
+}
+
+const char *LaneKernelName(void)
+{
+    SelectLaneKernel();
+    return laneKernelName;
+}
+
+// ------------------------------------------------------------------------------------
+// Buffers
+// ------------------------------------------------------------------------------------
+void LaneBuffers::Resize(int count)
+{
+    std::vector<int16_t> *arrays[] = {&headX, &headY, &direction, &foodX, &foodY, &nextX, &nextY, &hitWall, &ateFood};
+    for (std::vector<int16_t> *array : arrays)
+    {
+        array->assign((size_t)count, 0);
+    }
+}
+
+LaneState LaneBuffers::State(void)
+{
+    return {headX.data(), headY.data(), direction.data(), foodX.data(), foodY.data()};
+}
+
+LaneResult LaneBuffers::Result(void)
+{
+    return {nextX.data(), nextY.data(), hitWall.data(), ateFood.data()};
+}
@@ -0,0 +1,91 @@
+#include "MenuScreen.h"
+#include "Constants.h"
+#include "Game.h"
+
+MenuScreen::MenuScreen(void)
+    : titleLabel("SNAKE", 60, DARKGREEN),
+      itemLabels{
+          {"Play", 30, DARKGRAY},
+          {"2 Players", 30, DARKGRAY},
+          {"Online", 30, DARKGRAY},
+          {"Options", 30, DARKGRAY},
+          {"Quit", 30, DARKGRAY}},
+      selected(ITEM_PLAY)
+{
+}
+
+void MenuScreen::Load(void)
+{
+    titleLabel.Load();
+    for (StaticLabel &label : itemLabels)
+    {
+        label.Load();
+    }
+}
+
+void MenuScreen::Unload(void)
+{
+    titleLabel.Unload();
+    for (StaticLabel &label : itemLabels)
+    {
+        label.Unload();
+    }
+}
+
+void MenuScreen::Enter(Game &)
+{
+    selected = ITEM_PLAY;
+}
+
+void MenuScreen::Update(Game &game, float)
+{
+    if (IsKeyPressed(KEY_DOWN))
+        selected = (selected + 1) % ITEM_COUNT;
+    if (IsKeyPressed(KEY_UP))
+        selected = (selected + ITEM_COUNT - 1) % ITEM_COUNT;
+
+    if (IsKeyPressed(KEY_ESCAPE))
+    {
+        game.Quit();
+        return;
+    }
+
+    if (IsKeyPressed(KEY_ENTER))
+    {
+        switch (selected)
+        {
+        case ITEM_PLAY:
+            game.ChangeScreen(SCREEN_PLAY);
+            break;
+        case ITEM_VERSUS:
+            game.ChangeScreen(SCREEN_VERSUS);
+            break;
+        case ITEM_ONLINE:
+            game.ChangeScreen(SCREEN_ONLINE);
+            break;
+        case ITEM_OPTIONS:
+            game.PushScreen(SCREEN_OPTIONS); // 选项关闭后回到菜单
+            break;
+        case ITEM_QUIT:
+            game.Quit();
+            break;
+        }
+    }
+}
+
+void MenuScreen::Draw(const Game &)
+{
+    const int centerX = SCREEN_WIDTH / 2;
+
+    titleLabel.DrawCentered(centerX, SCREEN_HEIGHT / 4);
+
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        int y = SCREEN_HEIGHT / 2 + i * 50;
+        if (i == selected)
+        {
+            DrawRectangle(centerX - 120, y - 8, 240, 46, LIGHTGRAY); // 当前选中的菜单项
+        }
+        itemLabels[i].DrawCentered(centerX, y);
+    }
+}
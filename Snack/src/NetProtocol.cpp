@@ -0,0 +1,283 @@
+#include "NetProtocol.h"
+
+// ------------------------------------------------------------------------------------
+// NetWriter / NetReader
+// ------------------------------------------------------------------------------------
+void NetWriter::Put(uint32_t value, int bytes)
+{
+    if (!ok || capacity - size < (size_t)bytes)
+    {
+        ok = false;
+        return;
+    }
+    for (int i = 0; i < bytes; i++)
+    {
+        data[size++] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+uint8_t *NetWriter::Reserve(size_t count)
+{
+    if (!ok || capacity - size < count)
+    {
+        ok = false;
+        return nullptr;
+    }
+    uint8_t *start = data + size;
+    size += count;
+    return start;
+}
+
+uint32_t NetReader::Get(int bytes)
+{
+    if (!ok || size - offset < (size_t)bytes)
+    {
+        ok = false;
+        return 0;
+    }
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++)
+    {
+        value |= (uint32_t)data[offset++] << (8 * i);
+    }
+    return value;
+}
+
+const uint8_t *NetReader::Skip(size_t count)
+{
+    if (!ok || size - offset < count)
+    {
+        ok = false;
+        return nullptr;
+    }
+    const uint8_t *start = data + offset;
+    offset += count;
+    return start;
+}
+
+// ------------------------------------------------------------------------------------
+// Encoding
+// ------------------------------------------------------------------------------------
+size_t WriteJoin(uint8_t *out, size_t capacity, uint32_t room)
+{
+    NetWriter writer(out, capacity);
+    writer.U8(NET_JOIN);
+    writer.U8(NET_PROTOCOL_VERSION);
+    writer.U32(room);
+    return writer.Finish();
+}
+
+size_t WriteInput(uint8_t *out, size_t capacity, uint32_t tick, SnakeDirection direction)
+{
+    NetWriter writer(out, capacity);
+    writer.U8(NET_INPUT);
+    writer.U32(tick);
+    writer.U8((uint32_t)direction);
+    return writer.Finish();
+}
+
+size_t WriteLeave(uint8_t *out, size_t capacity)
+{
+    NetWriter writer(out, capacity);
+    writer.U8(NET_LEAVE);
+    return writer.Finish();
+}
+
+size_t WriteWelcome(uint8_t *out, size_t capacity, uint32_t room, int player, int playerCount)
+{
+    NetWriter writer(out, capacity);
+    writer.U8(NET_WELCOME);
+    writer.U32(room);
+    writer.U8((uint32_t)player);
+    writer.U8((uint32_t)playerCount);
+    return writer.Finish();
+}
+
+size_t WriteRoomFull(uint8_t *out, size_t capacity, uint32_t room)
+{
+    NetWriter writer(out, capacity);
+    writer.U8(NET_ROOM_FULL);
+    writer.U32(room);
+    return writer.Finish();
+}
+
+size_t WriteDeltas(uint8_t *out, size_t capacity, uint32_t room, uint16_t round, int playerCount,
+                   const NetDelta *deltas, int count)
+{
+    NetWriter writer(out, capacity);
+    writer.U8(NET_DELTAS);
+    writer.U32(room);
+    writer.U16(round);
+    writer.U8((uint32_t)playerCount);
+    writer.U32(count > 0 ? deltas[0].tick : 0);
+    writer.U8((uint32_t)count);
+    for (int i = 0; i < count; i++)
+    {
+        const NetDelta &delta = deltas[i];
+        writer.U8(delta.flags);
+        for (int p = 0; p < playerCount; p++)
+        {
+            writer.U8(delta.players[p]);
+        }
+        if (delta.flags & NET_FOOD_EVENT)
+        {
+            writer.I16(delta.food.x);
+            writer.I16(delta.food.y);
+        }
+    }
+    return writer.Finish();
+}
+
+// ------------------------------------------------------------------------------------
+// Decoding
+// ------------------------------------------------------------------------------------
+bool ReadJoin(const uint8_t *data, size_t size, uint8_t &version, uint32_t &room)
+{
+    NetReader reader(data, size);
+    if (reader.U8() != NET_JOIN)
+        return false;
+    version = (uint8_t)reader.U8();
+    room = reader.U32();
+    return reader.AtEnd();
+}
+
+bool ReadInput(const uint8_t *data, size_t size, uint32_t &tick, SnakeDirection &direction)
+{
+    NetReader reader(data, size);
+    if (reader.U8() != NET_INPUT)
+        return false;
+    tick = reader.U32();
+    uint32_t value = reader.U8();
+    direction = (SnakeDirection)(value & NET_DIRECTION_MASK);
+    return reader.AtEnd() && value <= DIR_DOWN;
+}
+
+bool ReadWelcome(const uint8_t *data, size_t size, uint32_t &room, int &player, int &playerCount)
+{
+    NetReader reader(data, size);
+    if (reader.U8() != NET_WELCOME)
+        return false;
+    room = reader.U32();
+    player = (int)reader.U8();
+    playerCount = (int)reader.U8();
+    return reader.AtEnd() && playerCount >= 1 && playerCount <= MAX_PLAYERS && player < playerCount;
+}
+
+bool ReadRoomFull(const uint8_t *data, size_t size, uint32_t &room)
+{
+    NetReader reader(data, size);
+    if (reader.U8() != NET_ROOM_FULL)
+        return false;
+    room = reader.U32();
+    return reader.AtEnd();
+}
+
+bool ReadKeyframe(const uint8_t *data, size_t size, int width, int height, NetKeyframe &keyframe)
+{
+    NetReader reader(data, size);
+    if (reader.U8() != NET_KEYFRAME)
+        return false;
+
+    keyframe.room = reader.U32();
+    keyframe.round = (uint16_t)reader.U16();
+    keyframe.tick = reader.U32();
+    uint32_t status = reader.U8();
+    keyframe.winner = (int8_t)(uint8_t)reader.U8();
+    keyframe.playerCount = (int)reader.U8();
+    keyframe.food.position.x = (int16_t)reader.I16();
+    keyframe.food.position.y = (int16_t)reader.I16();
+    keyframe.food.active = reader.U8() != 0;
+    if (!reader.Ok() || status > SIM_WON || keyframe.playerCount < 1 || keyframe.playerCount > MAX_PLAYERS ||
+        keyframe.winner < -1 || keyframe.winner >= keyframe.playerCount)
+        return false;
+    keyframe.status = (SimStatus)status;
+
+    const DynamicBoard board(width, height);
+    if (keyframe.food.active && !board.Contains(keyframe.food.position))
+        return false;
+
+    // 同一个格子出现两次 (自己交叉或者和别的蛇重叠) 会让副本的占用位图和空闲格子索引错乱
+    keyframe.cells.assign((size_t)(board.CellCount() + 63) / 64, 0);
+    auto claim = [&keyframe, &board](Cell claimed) {
+        const int index = board.Index(claimed);
+        uint64_t &word = keyframe.cells[(size_t)(index >> 6)];
+        const uint64_t bit = (uint64_t)1 << (index & 63);
+        if (word & bit)
+            return false;
+        word |= bit;
+        return true;
+    };
+
+    int totalLength = 0;
+    for (int p = 0; p < keyframe.playerCount; p++)
+    {
+        NetKeyframe::Player &player = keyframe.players[p];
+        player.alive = reader.U8() != 0;
+        player.direction = (SnakeDirection)(reader.U8() & NET_DIRECTION_MASK);
+        player.score = reader.I32();
+        int length = (int)reader.U16();
+        Cell cell = {(int16_t)reader.I16(), (int16_t)reader.I16()};
+        totalLength += length;
+        if (!reader.Ok() || totalLength > board.CellCount() || (player.alive && length == 0))
+            return false;
+
+        player.body.clear();
+        if (length == 0)
+            continue;
+
+        const uint8_t *packed = reader.Skip((size_t)(length - 1 + 3) / 4);
+        if (packed == nullptr || !board.Contains(cell) || !claim(cell))
+            return false;
+        player.body.push_back(cell);
+        for (int i = 1; i < length; i++)
+        {
+            int bit = (i - 1) * 2;
+            cell = MoveCell(cell, (SnakeDirection)((packed[bit / 8] >> (bit % 8)) & NET_DIRECTION_MASK));
+            if (!board.Contains(cell) || !claim(cell))
+                return false;
+            player.body.push_back(cell);
+        }
+    }
+    return reader.AtEnd();
+}
+
+bool ReadDeltas(const uint8_t *data, size_t size, int width, int height, uint32_t &room, uint16_t &round,
+                int &playerCount, NetDelta *deltas, int &count)
+{
+    NetReader reader(data, size);
+    if (reader.U8() != NET_DELTAS)
+        return false;
+
+    room = reader.U32();
+    round = (uint16_t)reader.U16();
+    playerCount = (int)reader.U8();
+    uint32_t firstTick = reader.U32();
+    count = (int)reader.U8();
+    if (!reader.Ok() || playerCount < 1 || playerCount > MAX_PLAYERS || count > NET_DELTA_REDUNDANCY)
+        return false;
+
+    const DynamicBoard board(width, height);
+    for (int i = 0; i < count; i++)
+    {
+        NetDelta &delta = deltas[i];
+        delta = NetDelta{};
+        delta.tick = firstTick + (uint32_t)i;
+        delta.flags = (uint8_t)reader.U8();
+        for (int p = 0; p < playerCount; p++)
+        {
+            delta.players[p] = (uint8_t)reader.U8();
+        }
+        if (delta.flags & NET_FOOD_EVENT)
+        {
+            delta.food.x = (int16_t)reader.I16();
+            delta.food.y = (int16_t)reader.I16();
+            if (!board.Contains(delta.food))
+                return false;
+        }
+    }
+    return reader.AtEnd();
+}
+
+// 常用棋盘的显式实例化, 其它 FixedBoard 在使用处按需实例化
+template class BasicNetReplica<DynamicBoard>;
+template class BasicNetReplica<ClassicBoard>;
@@ -0,0 +1,559 @@
+#include "NetServer.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const int SOCKET_BUFFER_BYTES = 4 << 20; // 几千个房间一个 tick 的数据报能放进内核缓冲区
+static const int ROOM_GRAIN = 16;               // 每个线程一次领取的房间数
+static const int64_t STATS_INTERVAL_MICROS = 5000000;
+static const int64_t TIMEOUT_SCAN_MICROS = 1000000;
+
+static uint64_t AddressKey(const sockaddr_in &address)
+{
+    return ((uint64_t)ntohl(address.sin_addr.s_addr) << 16) | ntohs(address.sin_port);
+}
+
+NetServer::NetServer(void)
+    : config{}, socketFd(-1), epollFd(-1), boundPort(0), openRoomHint(0), sendCount(0), stats{}
+{
+}
+
+NetServer::~NetServer(void)
+{
+    Close();
+}
+
+int64_t NetServer::NowMicros(void)
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+bool NetServer::Open(const NetServerConfig &newConfig)
+{
+    Close();
+    config = newConfig;
+    if (config.roomCount < 1 || config.playersPerRoom < 1 || config.playersPerRoom > MAX_PLAYERS ||
+        config.tickMicros == 0)
+    {
+        fprintf(stderr, "invalid server configuration\n");
+        return false;
+    }
+
+    socketFd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (socketFd < 0)
+    {
+        perror("socket");
+        return false;
+    }
+    int enable = 1;
+    setsockopt(socketFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    int bufferBytes = SOCKET_BUFFER_BYTES;
+    setsockopt(socketFd, SOL_SOCKET, SO_SNDBUF, &bufferBytes, sizeof(bufferBytes));
+    setsockopt(socketFd, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(config.port);
+    if (bind(socketFd, (const sockaddr *)&address, sizeof(address)) != 0)
+    {
+        perror("bind");
+        Close();
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    getsockname(socketFd, (sockaddr *)&address, &length);
+    boundPort = ntohs(address.sin_port);
+
+    epollFd = epoll_create1(0);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, socketFd, &event) != 0)
+    {
+        perror("epoll");
+        Close();
+        return false;
+    }
+
+    // 所有房间和客户端槽一次分配好
+    rooms = std::vector<Room>((size_t)config.roomCount);
+    for (Room &room : rooms)
+    {
+        for (int &client : room.clients)
+            client = -1;
+        room.state = ROOM_WAITING;
+        room.seated = 0;
+        room.round = 0;
+    }
+    activeRooms.clear();
+    activeRooms.reserve(rooms.size());
+    activeSlot.assign(rooms.size(), -1);
+    openRoomHint = 0;
+
+    const int clientCount = config.roomCount * config.playersPerRoom;
+    clients.assign((size_t)clientCount, Client{});
+    freeClients.clear();
+    for (int i = clientCount - 1; i >= 0; i--)
+    {
+        clients[i].room = -1;
+        freeClients.push_back(i);
+    }
+    clientByAddress.clear();
+    clientByAddress.reserve((size_t)clientCount);
+
+    // 成批收发的消息头预先指向各自的缓冲区, 每次只需要填长度和地址
+    recvBuffers.assign((size_t)RECV_BATCH * NET_MAX_DATAGRAM, 0);
+    recvHeaders.assign(RECV_BATCH, mmsghdr{});
+    recvVectors.assign(RECV_BATCH, iovec{});
+    recvAddresses.assign(RECV_BATCH, sockaddr_in{});
+    for (int i = 0; i < RECV_BATCH; i++)
+    {
+        recvVectors[i] = {&recvBuffers[(size_t)i * NET_MAX_DATAGRAM], NET_MAX_DATAGRAM};
+        recvHeaders[i].msg_hdr.msg_iov = &recvVectors[i];
+        recvHeaders[i].msg_hdr.msg_iovlen = 1;
+        recvHeaders[i].msg_hdr.msg_name = &recvAddresses[i];
+    }
+    sendHeaders.assign(SEND_BATCH, mmsghdr{});
+    sendVectors.assign(SEND_BATCH, iovec{});
+    sendAddresses.assign(SEND_BATCH, sockaddr_in{});
+    for (int i = 0; i < SEND_BATCH; i++)
+    {
+        sendHeaders[i].msg_hdr.msg_iov = &sendVectors[i];
+        sendHeaders[i].msg_hdr.msg_iovlen = 1;
+        sendHeaders[i].msg_hdr.msg_name = &sendAddresses[i];
+        sendHeaders[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+    sendCount = 0;
+
+    pool.reset(new ThreadPool(config.threads));
+    stats = NetServerStats{};
+    return true;
+}
+
+void NetServer::Close(void)
+{
+    if (epollFd >= 0)
+        close(epollFd);
+    if (socketFd >= 0)
+        close(socketFd);
+    epollFd = -1;
+    socketFd = -1;
+}
+
+// ------------------------------------------------------------------------------------
+// Main Loop
+// ------------------------------------------------------------------------------------
+void NetServer::Run(const std::atomic<bool> &stop)
+{
+    int64_t nextTick = NowMicros() + config.tickMicros;
+    int64_t nextTimeoutScan = nextTick + TIMEOUT_SCAN_MICROS;
+    int64_t nextStats = nextTick + STATS_INTERVAL_MICROS;
+
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        int64_t now = NowMicros();
+        if (now >= nextTick)
+        {
+            Tick();
+            // 截止时间按整数微秒累加, 不会漂移; 落后太多时 (例如被调试器暂停) 不再追赶
+            nextTick += config.tickMicros;
+            if (now - nextTick > (int64_t)config.tickMicros * 8)
+                nextTick = now + config.tickMicros;
+            continue;
+        }
+
+        if (now >= nextTimeoutScan)
+        {
+            DropSilentClients(now);
+            nextTimeoutScan = now + TIMEOUT_SCAN_MICROS;
+        }
+        if (config.verbose && now >= nextStats)
+        {
+            printf("tick %llu: %d clients, %d rooms playing, %llu packets out (%llu dropped), %llu in\n",
+                   (unsigned long long)stats.ticks, stats.clients, stats.playingRooms,
+                   (unsigned long long)stats.packetsOut, (unsigned long long)stats.sendDropped,
+                   (unsigned long long)stats.packetsIn);
+            fflush(stdout);
+            nextStats = now + STATS_INTERVAL_MICROS;
+        }
+
+        // 等到下一个 tick 或者有数据报到达
+        epoll_event event;
+        int timeoutMs = (int)((nextTick - now + 999) / 1000);
+        int ready = epoll_wait(epollFd, &event, 1, timeoutMs);
+        if (ready > 0)
+            ReceiveAll(NowMicros());
+    }
+}
+
+void NetServer::Tick(void)
+{
+    stats.ticks++;
+
+    // 每个房间只写自己的状态和缓冲区, 可以按块并行
+    pool->ParallelFor((int)activeRooms.size(), ROOM_GRAIN, [this](int begin, int end) {
+        for (int i = begin; i < end; i++)
+            StepRoom(activeRooms[i]);
+    });
+
+    int playing = 0;
+    for (int index : activeRooms)
+    {
+        if (rooms[index].state == ROOM_PLAYING)
+            playing++;
+    }
+    stats.playingRooms = playing;
+    stats.roomTicks += (uint64_t)playing;
+
+    SendTick();
+}
+
+// ------------------------------------------------------------------------------------
+// Rooms
+// ------------------------------------------------------------------------------------
+int NetServer::FindOpenRoom(void)
+{
+    // 房间按顺序坐满, 提示位置之前的房间在有人离开之前都是满的
+    for (int i = 0; i < config.roomCount; i++)
+    {
+        int index = (openRoomHint + i) % config.roomCount;
+        const Room &room = rooms[index];
+        if (room.state != ROOM_PLAYING && room.seated < config.playersPerRoom)
+        {
+            openRoomHint = index;
+            return index;
+        }
+    }
+    return -1;
+}
+
+void NetServer::StartRound(int index)
+{
+    Room &room = rooms[index];
+    room.round++;
+    room.sim.Reset(ClassicBoard(), config.playersPerRoom, ((uint64_t)config.seed << 32) | room.round,
+                   (uint64_t)index);
+    for (int p = 0; p < config.playersPerRoom; p++)
+    {
+        room.inputs[p] = room.sim.Direction(p);
+    }
+    memset(room.scheduled, 0, sizeof(room.scheduled));
+    room.historyCount = 0;
+    room.state = ROOM_PLAYING;
+    room.keyframeDue = true;
+    room.sinceKeyframe = 0;
+}
+
+void NetServer::StepRoom(int index)
+{
+    Room &room = rooms[index];
+    room.deltaSize = 0;
+    room.keyframeSize = 0;
+
+    if (room.state == ROOM_FINISHED)
+    {
+        if (--room.countdown == 0)
+        {
+            if (room.seated == config.playersPerRoom)
+                StartRound(index);
+            else
+                room.state = ROOM_WAITING;
+        }
+    }
+    else if (room.state == ROOM_PLAYING && !(room.keyframeDue && room.sim.Ticks() == 0))
+    {
+        // 开局的关键帧单独占一个 tick 先发出去, 之后每个 tick 推进一次
+        const uint32_t next = (uint32_t)room.sim.Ticks() + 1;
+        for (int p = 0; p < room.sim.PlayerCount(); p++)
+        {
+            const ScheduledInput &input = room.scheduled[p][next % NET_INPUT_WINDOW];
+            if (input.tick == next)
+                room.inputs[p] = input.direction; // 没有排队的 tick 沿用上一个方向
+        }
+        MultiStepResult step = room.sim.Step(room.inputs);
+        if (room.historyCount == NET_DELTA_REDUNDANCY)
+        {
+            memmove(&room.history[0], &room.history[1], sizeof(NetDelta) * (NET_DELTA_REDUNDANCY - 1));
+            room.historyCount--;
+        }
+        room.history[room.historyCount++] = MakeDelta(room.sim, step, room.inputs);
+        room.deltaSize = WriteDeltas(room.deltaPacket, sizeof(room.deltaPacket), (uint32_t)index, room.round,
+                                     room.sim.PlayerCount(), room.history, room.historyCount);
+
+        if (!room.sim.Running())
+        {
+            room.state = ROOM_FINISHED;
+            room.countdown = ROUND_RESTART_TICKS;
+        }
+        if (++room.sinceKeyframe >= NET_KEYFRAME_INTERVAL)
+            room.keyframeDue = true;
+    }
+
+    if (room.keyframeDue && room.state == ROOM_PLAYING)
+    {
+        room.keyframeSize = WriteKeyframe(room.keyframePacket, sizeof(room.keyframePacket), (uint32_t)index,
+                                          room.round, room.sim);
+        room.keyframeDue = false;
+        room.sinceKeyframe = 0;
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Clients
+// ------------------------------------------------------------------------------------
+void NetServer::ReceiveAll(int64_t now)
+{
+    for (;;)
+    {
+        for (int i = 0; i < RECV_BATCH; i++)
+        {
+            recvHeaders[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            recvHeaders[i].msg_hdr.msg_flags = 0;
+        }
+        int count = recvmmsg(socketFd, recvHeaders.data(), RECV_BATCH, MSG_DONTWAIT, nullptr);
+        if (count <= 0)
+            return; // EAGAIN: 这一批收完了
+
+        stats.packetsIn += (uint64_t)count;
+        for (int i = 0; i < count; i++)
+        {
+            const msghdr &header = recvHeaders[i].msg_hdr;
+            if ((header.msg_flags & MSG_TRUNC) || header.msg_namelen != sizeof(sockaddr_in))
+            {
+                stats.badPackets++;
+                continue;
+            }
+            HandleDatagram(recvAddresses[i], &recvBuffers[(size_t)i * NET_MAX_DATAGRAM], recvHeaders[i].msg_len,
+                           now);
+        }
+        if (count < RECV_BATCH)
+            return;
+    }
+}
+
+void NetServer::HandleDatagram(const sockaddr_in &address, const uint8_t *data, size_t size, int64_t now)
+{
+    const uint64_t key = AddressKey(address);
+    if (MessageType(data, size) == NET_JOIN)
+    {
+        uint8_t version;
+        uint32_t room;
+        if (!ReadJoin(data, size, version, room) || version != NET_PROTOCOL_VERSION)
+        {
+            stats.badPackets++;
+            return;
+        }
+        HandleJoin(address, key, room, now);
+        return;
+    }
+
+    auto found = clientByAddress.find(key);
+    if (found == clientByAddress.end())
+        return; // 不认识的地址 (可能已经超时), 等它重新 JOIN
+
+    Client &client = clients[found->second];
+    client.lastHeard = now;
+    switch (MessageType(data, size))
+    {
+    case NET_INPUT:
+    {
+        uint32_t tick;
+        SnakeDirection direction;
+        if (ReadInput(data, size, tick, direction))
+            HandleInput(rooms[client.room], client.seat, tick, direction);
+        else
+            stats.badPackets++;
+        break;
+    }
+    case NET_LEAVE:
+        RemoveClient(found->second);
+        break;
+    default:
+        stats.badPackets++;
+        break;
+    }
+}
+
+void NetServer::HandleInput(Room &room, int seat, uint32_t tick, SnakeDirection direction)
+{
+    const uint32_t next = (uint32_t)room.sim.Ticks() + 1;
+    ScheduledInput &slot = room.scheduled[seat][(tick < next ? next : tick) % NET_INPUT_WINDOW];
+    if (tick < next)
+    {
+        // 晚到了: 在下一个 tick 生效, 但不覆盖按时到达的 (更新的) 输入
+        if (slot.tick != next)
+            slot = ScheduledInput{next, direction};
+    }
+    else if (tick - next < NET_INPUT_WINDOW)
+    {
+        slot = ScheduledInput{tick, direction};
+    }
+}
+
+void NetServer::HandleJoin(const sockaddr_in &address, uint64_t key, uint32_t requested, int64_t now)
+{
+    uint8_t packet[16];
+
+    // 重复的 JOIN (WELCOME 丢了): 再告诉它一次, 顺便补一个关键帧
+    auto found = clientByAddress.find(key);
+    if (found != clientByAddress.end())
+    {
+        Client &client = clients[found->second];
+        client.lastHeard = now;
+        rooms[client.room].keyframeDue = true;
+        SendNow(address, packet, WriteWelcome(packet, sizeof(packet), (uint32_t)client.room, client.seat,
+                                              config.playersPerRoom));
+        return;
+    }
+
+    int index = -1;
+    if (requested == NET_ANY_ROOM)
+        index = FindOpenRoom();
+    else if (requested < (uint32_t)config.roomCount && rooms[requested].state != ROOM_PLAYING &&
+             rooms[requested].seated < config.playersPerRoom)
+        index = (int)requested;
+    if (index < 0 || freeClients.empty())
+    {
+        SendNow(address, packet, WriteRoomFull(packet, sizeof(packet), requested));
+        return;
+    }
+
+    Room &room = rooms[index];
+    int seat = 0;
+    while (room.clients[seat] >= 0)
+        seat++;
+
+    int slot = freeClients.back();
+    freeClients.pop_back();
+    Client &client = clients[slot];
+    client.key = key;
+    client.address = address;
+    client.room = index;
+    client.seat = seat;
+    client.lastHeard = now;
+    clientByAddress[key] = slot;
+    stats.clients++;
+
+    room.clients[seat] = slot;
+    room.seated++;
+    if (activeSlot[index] < 0)
+    {
+        activeSlot[index] = (int)activeRooms.size();
+        activeRooms.push_back(index);
+    }
+
+    SendNow(address, packet, WriteWelcome(packet, sizeof(packet), (uint32_t)index, seat, config.playersPerRoom));
+    if (room.state == ROOM_WAITING && room.seated == config.playersPerRoom)
+        StartRound(index);
+}
+
+void NetServer::RemoveClient(int slot)
+{
+    Client &client = clients[slot];
+    Room &room = rooms[client.room];
+    room.clients[client.seat] = -1;
+    room.seated--;
+    // 进行中的一局继续, 空座位上的蛇保持最后的方向
+
+    if (room.seated == 0)
+    {
+        // 房间空了: 放弃这一局, 从 activeRooms 里 swap-remove
+        room.state = ROOM_WAITING;
+        int position = activeSlot[client.room];
+        int last = activeRooms.back();
+        activeRooms[position] = last;
+        activeSlot[last] = position;
+        activeRooms.pop_back();
+        activeSlot[client.room] = -1;
+    }
+    if (room.state != ROOM_PLAYING && client.room < openRoomHint)
+        openRoomHint = client.room;
+
+    clientByAddress.erase(client.key);
+    client.room = -1;
+    freeClients.push_back(slot);
+    stats.clients--;
+}
+
+void NetServer::DropSilentClients(int64_t now)
+{
+    for (int i = 0; i < (int)clients.size(); i++)
+    {
+        if (clients[i].room >= 0 && now - clients[i].lastHeard > CLIENT_TIMEOUT_MICROS)
+            RemoveClient(i);
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Sending
+// ------------------------------------------------------------------------------------
+void NetServer::SendTick(void)
+{
+    for (int index : activeRooms)
+    {
+        const Room &room = rooms[index];
+        for (int p = 0; p < config.playersPerRoom; p++)
+        {
+            if (room.clients[p] < 0)
+                continue;
+            const Client &client = clients[room.clients[p]];
+            if (room.keyframeSize > 0)
+                Queue(client, room.keyframePacket, room.keyframeSize);
+            if (room.deltaSize > 0)
+                Queue(client, room.deltaPacket, room.deltaSize);
+        }
+    }
+    Flush();
+}
+
+void NetServer::Queue(const Client &client, const uint8_t *data, size_t size)
+{
+    if (sendCount == SEND_BATCH)
+        Flush();
+
+    sendAddresses[sendCount] = client.address;
+    sendVectors[sendCount] = {(void *)data, size};
+    sendCount++;
+}
+
+void NetServer::Flush(void)
+{
+    int offset = 0;
+    while (offset < sendCount)
+    {
+        int sent = sendmmsg(socketFd, &sendHeaders[offset], (unsigned)(sendCount - offset), 0);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            stats.sendDropped += (uint64_t)(sendCount - offset); // 内核缓冲区满了 (EAGAIN), 丢掉这一批剩下的
+            break;
+        }
+        for (int i = 0; i < sent; i++)
+        {
+            stats.bytesOut += sendHeaders[offset + i].msg_len;
+        }
+        stats.packetsOut += (uint64_t)sent;
+        offset += sent;
+    }
+    sendCount = 0;
+}
+
+void NetServer::SendNow(const sockaddr_in &address, const uint8_t *data, size_t size)
+{
+    if (size == 0)
+        return;
+    if (sendto(socketFd, data, size, 0, (const sockaddr *)&address, sizeof(address)) >= 0)
+    {
+        stats.packetsOut++;
+        stats.bytesOut += size;
+    }
+}
@@ -0,0 +1,157 @@
+#include "NetSession.h"
+#include "Constants.h"
+
+NetSession::NetSession(void)
+    : replica(), predictor(), keyframe(), lastStep{}, requestedRoom(NET_ANY_ROOM), room(0), player(0), welcomed(false),
+      roomFull(false), predicting(false), predictedRound(0), inputLead(MIN_LEAD), onTimeTicks(0),
+      seenMispredictions(0), sinceRejoin(0), desyncs(0), gaps(0)
+{
+}
+
+void NetSession::Reset(uint32_t newRoom)
+{
+    replica.Invalidate();
+    requestedRoom = newRoom;
+    welcomed = false;
+    roomFull = false;
+    predicting = false;
+    inputLead = MIN_LEAD;
+    onTimeTicks = 0;
+    seenMispredictions = predictor.LocalMispredictions();
+    sinceRejoin = 0;
+}
+
+void NetSession::Receive(const uint8_t *data, size_t size)
+{
+    switch (MessageType(data, size))
+    {
+    case NET_WELCOME:
+    {
+        uint32_t newRoom;
+        int newPlayer;
+        int playerCount;
+        if (!ReadWelcome(data, size, newRoom, newPlayer, playerCount))
+            break;
+        if (welcomed && (newRoom != room || newPlayer != player))
+        {
+            // 服务器把我们当成了新客户端 (之前超时了): 换了座位, 旧的副本作废
+            replica.Invalidate();
+            predicting = false;
+        }
+        welcomed = true;
+        roomFull = false;
+        room = newRoom;
+        player = newPlayer;
+        break;
+    }
+    case NET_ROOM_FULL:
+        if (!welcomed)
+            roomFull = true; // 继续定期重发 JOIN, 有空位时就能进
+        break;
+    case NET_KEYFRAME:
+        if (welcomed && ReadKeyframe(data, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe) &&
+            keyframe.room == room && replica.ApplyKeyframe(ClassicBoard(), keyframe))
+            Reconcile();
+        break;
+    case NET_DELTAS:
+    {
+        uint32_t deltaRoom;
+        uint16_t round;
+        int playerCount;
+        int count;
+        NetDelta deltas[NET_DELTA_REDUNDANCY];
+        if (!welcomed ||
+            !ReadDeltas(data, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, deltaRoom, round, playerCount, deltas, count) ||
+            deltaRoom != room)
+            break;
+
+        bool advanced = false;
+        for (int i = 0; i < count; i++)
+        {
+            switch (replica.ApplyDelta(round, deltas[i]))
+            {
+            case NET_APPLIED:
+                advanced = true;
+                break;
+            case NET_GAP:
+                gaps++;
+                break;
+            case NET_DESYNC:
+                desyncs++;
+                break;
+            default:
+                break;
+            }
+        }
+
+        // 一个数据报里的多个 delta 只需要和最新的权威状态对账一次
+        if (advanced && replica.Synced())
+            Reconcile();
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void NetSession::Reconcile(void)
+{
+    const ClassicMultiSimulation &sim = replica.GetSimulation();
+    if (predicting && predictedRound == replica.Round())
+    {
+        predictor.Reconcile(sim);
+        return;
+    }
+
+    // 新的一局: 从关键帧重新开始预测
+    predictor.Reset(sim, player);
+    predicting = true;
+    predictedRound = replica.Round();
+    lastStep = {};
+    for (int p = 0; p < sim.PlayerCount(); p++)
+    {
+        lastStep.players[p].prevHead = sim.GetSnake(p).Head().position;
+    }
+}
+
+size_t NetSession::Tick(SnakeDirection localInput, uint8_t *out, size_t capacity)
+{
+    if (!welcomed || (!replica.Synced() && ++sinceRejoin >= REJOIN_TICKS))
+    {
+        sinceRejoin = 0;
+        return WriteJoin(out, capacity, welcomed ? room : requestedRoom);
+    }
+    if (!predicting)
+        return WriteInput(out, capacity, (uint32_t)replica.GetSimulation().Ticks() + 1, localInput);
+
+    // 离目标领先量差得多时一次多推进一个 tick, 超过太多时这个 tick 停一下, 其余时候正好推进一个
+    const int lead = predictor.Lead();
+    const int steps = lead < inputLead ? 2 : (lead > inputLead + 2 ? 0 : 1);
+    const uint64_t firstTick = predictor.GetSimulation().Ticks() + 1;
+    for (int i = 0; i < steps; i++)
+    {
+        MultiStepResult step;
+        if (!predictor.Advance(localInput, &step))
+            break;
+        lastStep = step;
+    }
+
+    const uint64_t misses = predictor.LocalMispredictions();
+    if (misses != seenMispredictions)
+    {
+        seenMispredictions = misses;
+        onTimeTicks = 0;
+        if (inputLead < MAX_LEAD)
+            inputLead++;
+    }
+    else if (++onTimeTicks >= LEAD_DECAY_TICKS)
+    {
+        onTimeTicks = 0;
+        if (inputLead > MIN_LEAD)
+            inputLead--;
+    }
+
+    // 标上这个输入在服务器上开始生效的 tick: 服务器在没有排队输入的 tick 沿用上一个方向,
+    // 所以一次推进两个 tick 时标第一个就够了
+    return WriteInput(out, capacity, (uint32_t)firstTick, localInput);
+}
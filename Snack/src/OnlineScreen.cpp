@@ -0,0 +1,210 @@
+#include "OnlineScreen.h"
+#include "Audio.h"
+#include "Constants.h"
+#include "Game.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstring>
+
+OnlineScreen::OnlineScreen(void)
+    : lastQueuedDir(DIR_RIGHT), alpha(1.0f), connected(false),
+      scoreTexts{{"P1: %i", 20}, {"P2: %i", 20}, {"P3: %i", 20}, {"P4: %i", 20}}, winnerText("PLAYER %i WINS!", 40),
+      connectingLabel("CONNECTING...", 30, GRAY), waitingLabel("WAITING FOR PLAYERS...", 30, GRAY),
+      roomFullLabel("SERVER FULL, RETRYING...", 30, GRAY), drawLabel("DRAW", 40, GRAY),
+      noServerLabel("SERVER ADDRESS NOT FOUND", 30, GRAY)
+{
+}
+
+void OnlineScreen::Load(void)
+{
+    renderer.Load(GAME_AREA_WIDTH, GAME_AREA_HEIGHT, SQUARE_SIZE);
+    connectingLabel.Load();
+    waitingLabel.Load();
+    roomFullLabel.Load();
+    drawLabel.Load();
+    noServerLabel.Load();
+}
+
+void OnlineScreen::Unload(void)
+{
+    noServerLabel.Unload();
+    drawLabel.Unload();
+    roomFullLabel.Unload();
+    waitingLabel.Unload();
+    connectingLabel.Unload();
+    renderer.Unload();
+}
+
+void OnlineScreen::Enter(Game &)
+{
+    Connect();
+}
+
+void OnlineScreen::Exit(Game &)
+{
+    uint8_t packet[16];
+    if (session.Welcomed())
+        socket.Send(packet, session.WriteGoodbye(packet, sizeof(packet)));
+    socket.Close();
+}
+
+void OnlineScreen::Connect(void)
+{
+    char host[256] = "127.0.0.1";
+    uint16_t port = DEFAULT_PORT;
+    const char *address = getenv("SNAKE_SERVER");
+    if (address != nullptr && address[0] != '\0')
+    {
+        strncpy(host, address, sizeof(host) - 1);
+        host[sizeof(host) - 1] = '\0';
+        char *colon = strrchr(host, ':');
+        if (colon != nullptr)
+        {
+            *colon = '\0';
+            port = (uint16_t)atoi(colon + 1);
+        }
+    }
+
+    session.Reset();
+    pendingTurns.Clear();
+    lastQueuedDir = DIR_RIGHT;
+    clock.Reset(MOVE_INTERVAL_MICROS);
+    alpha = 1.0f;
+    connected = socket.Open(host, port);
+}
+
+void OnlineScreen::ReceiveAll(void)
+{
+    uint8_t buffer[NET_MAX_DATAGRAM];
+    for (int size = socket.Receive(buffer, sizeof(buffer)); size >= 0; size = socket.Receive(buffer, sizeof(buffer)))
+    {
+        session.Receive(buffer, (size_t)size);
+    }
+}
+
+void OnlineScreen::HandleInput(void)
+{
+    if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
+        QueueTurn(DIR_RIGHT);
+    if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
+        QueueTurn(DIR_LEFT);
+    if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W))
+        QueueTurn(DIR_UP);
+    if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S))
+        QueueTurn(DIR_DOWN);
+}
+
+void OnlineScreen::QueueTurn(SnakeDirection dir)
+{
+    if (dir == lastQueuedDir || IsOpposite(dir, lastQueuedDir))
+        return;
+
+    if (pendingTurns.Push(dir))
+        lastQueuedDir = dir;
+}
+
+void OnlineScreen::Update(Game &game, float frameTime)
+{
+    if (IsKeyPressed(KEY_ESCAPE))
+    {
+        game.ChangeScreen(SCREEN_MENU);
+        return;
+    }
+    if (!connected)
+        return;
+
+    const bool wasPlaying = session.Playing() && session.GetSimulation().Running();
+    ReceiveAll();
+
+    // 新的一局从关键帧开始, 排队的转向是上一局的
+    const ClassicMultiSimulation &sim = session.GetSimulation();
+    if (session.Playing() && sim.Running() && !wasPlaying)
+    {
+        pendingTurns.Clear();
+        lastQueuedDir = sim.Direction(session.LocalPlayer());
+    }
+
+    HandleInput();
+
+    clock.Advance(frameTime);
+
+    int steps = 0;
+    while (steps < MAX_STEPS_PER_FRAME && clock.Consume())
+    {
+        StepGame();
+        steps++;
+    }
+
+    clock.DropBacklog();
+    alpha = clock.Alpha();
+}
+
+void OnlineScreen::StepGame(void)
+{
+    SNAKE_PROFILE_SCOPE(PROFILE_STEP);
+
+    const ClassicMultiSimulation &sim = session.GetSimulation();
+    const int player = session.LocalPlayer();
+    const bool alive = session.Playing() && sim.Running() && sim.Alive(player);
+    const uint64_t ticks = sim.Ticks();
+
+    // 每个 tick 最多消费一次转向
+    SnakeDirection input = session.Playing() ? sim.Direction(player) : DIR_RIGHT;
+    if (alive)
+        pendingTurns.Pop(input);
+
+    uint8_t packet[NET_MAX_DATAGRAM];
+    socket.Send(packet, session.Tick(input, packet, sizeof(packet)));
+
+    // 音效跟着预测走: 回滚很少改变自己的蛇, 等服务器确认会慢一个往返
+    const MultiStepResult &step = session.LastStep();
+    if (alive && sim.Ticks() != ticks)
+    {
+        if (!sim.Alive(player))
+            PlayGameSound(SOUND_GAME_OVER);
+        else if (step.players[player].ateFood)
+            PlayGameSound(SOUND_EAT);
+    }
+}
+
+void OnlineScreen::Draw(const Game &)
+{
+    if (!connected)
+    {
+        noServerLabel.DrawCentered(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 15);
+        return;
+    }
+    if (!session.Playing())
+    {
+        const StaticLabel &label =
+            session.RoomFull() ? roomFullLabel : (session.Welcomed() ? waitingLabel : connectingLabel);
+        label.DrawCentered(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 15);
+        return;
+    }
+
+    const ClassicMultiSimulation &sim = session.GetSimulation();
+    renderer.Draw(sim, session.LastStep(), sim.Running() ? alpha : 1.0f);
+
+    // 分数按玩家颜色沿上边排开, 自己的在最左边
+    int x = 10;
+    for (int i = 0; i < sim.PlayerCount(); i++)
+    {
+        int p = (session.LocalPlayer() + i) % sim.PlayerCount();
+        scoreTexts[p].Set(sim.Score(p));
+        scoreTexts[p].Draw(x, 10, ViewportRenderer::PlayerColor(p, true));
+        x += scoreTexts[p].Width() + 30;
+    }
+
+    if (!sim.Running())
+    {
+        if (sim.Winner() >= 0)
+        {
+            winnerText.Set(sim.Winner() + 1);
+            winnerText.DrawCentered(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20, ViewportRenderer::PlayerColor(sim.Winner(), true));
+        }
+        else
+        {
+            drawLabel.DrawCentered(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20);
+        }
+    }
+}
@@ -0,0 +1,153 @@
+#include "OptionSreen.h"
+#include "Audio.h"
+#include "Constants.h"
+#include "Game.h"
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+struct BoardPreset
+{
+    int width;
+    int height;
+    const char *label;
+};
+
+// 第一个是一屏正好放下的经典大小, 其余由摄像机滚动显示
+static const BoardPreset BOARD_PRESETS[] = {
+    {GAME_AREA_WIDTH, GAME_AREA_HEIGHT, "Board: 40x30"},
+    {80, 60, "Board: 80x60"},
+    {200, 150, "Board: 200x150"},
+    {1000, 1000, "Board: 1000x1000"},
+    {MAX_BOARD_SIZE, MAX_BOARD_SIZE, "Board: 4096x4096"},
+};
+static_assert(sizeof(BOARD_PRESETS) / sizeof(BOARD_PRESETS[0]) == 5, "keep BOARD_PRESET_COUNT in sync");
+
+OptionScreen::OptionScreen(void)
+    : titleLabel("OPTIONS", 40, DARKGRAY),
+      soundOnLabel("Sound: On", 30, DARKGRAY),
+      soundOffLabel("Sound: Off", 30, DARKGRAY),
+      boardLabels{
+          {BOARD_PRESETS[0].label, 30, DARKGRAY},
+          {BOARD_PRESETS[1].label, 30, DARKGRAY},
+          {BOARD_PRESETS[2].label, 30, DARKGRAY},
+          {BOARD_PRESETS[3].label, 30, DARKGRAY},
+          {BOARD_PRESETS[4].label, 30, DARKGRAY},
+      },
+      speedLabels{
+          {GetSpeedCurve(SPEED_CLASSIC).label, 30, DARKGRAY},
+          {GetSpeedCurve(SPEED_GENTLE).label, 30, DARKGRAY},
+          {GetSpeedCurve(SPEED_FAST).label, 30, DARKGRAY},
+          {GetSpeedCurve(SPEED_INSANE).label, 30, DARKGRAY},
+      },
+      backLabel("Back", 30, DARKGRAY),
+      selected(ITEM_SOUND)
+{
+}
+
+void OptionScreen::Load(void)
+{
+    titleLabel.Load();
+    soundOnLabel.Load();
+    soundOffLabel.Load();
+    for (StaticLabel &label : boardLabels)
+    {
+        label.Load();
+    }
+    for (StaticLabel &label : speedLabels)
+    {
+        label.Load();
+    }
+    backLabel.Load();
+}
+
+void OptionScreen::Unload(void)
+{
+    titleLabel.Unload();
+    soundOnLabel.Unload();
+    soundOffLabel.Unload();
+    for (StaticLabel &label : boardLabels)
+    {
+        label.Unload();
+    }
+    for (StaticLabel &label : speedLabels)
+    {
+        label.Unload();
+    }
+    backLabel.Unload();
+}
+
+int OptionScreen::FindBoardPreset(const GameOptions &options)
+{
+    for (int i = 0; i < BOARD_PRESET_COUNT; i++)
+    {
+        if (BOARD_PRESETS[i].width == options.boardWidth && BOARD_PRESETS[i].height == options.boardHeight)
+            return i;
+    }
+    return 0;
+}
+
+void OptionScreen::Enter(Game &)
+{
+    selected = ITEM_SOUND;
+}
+
+void OptionScreen::Update(Game &game, float)
+{
+    if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_BACKSPACE))
+    {
+        game.PopScreen();
+        return;
+    }
+
+    if (IsKeyPressed(KEY_DOWN))
+        selected = (selected + 1) % ITEM_COUNT;
+    if (IsKeyPressed(KEY_UP))
+        selected = (selected + ITEM_COUNT - 1) % ITEM_COUNT;
+
+    GameOptions &options = game.Options();
+    bool activate = IsKeyPressed(KEY_ENTER);
+    if (selected == ITEM_SOUND && (activate || IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_RIGHT)))
+    {
+        options.soundEnabled = !options.soundEnabled;
+        SetGameSoundsEnabled(options.soundEnabled);
+    }
+    else if (selected == ITEM_BOARD && (activate || IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_RIGHT)))
+    {
+        int step = IsKeyPressed(KEY_LEFT) ? BOARD_PRESET_COUNT - 1 : 1;
+        const BoardPreset &preset = BOARD_PRESETS[(FindBoardPreset(options) + step) % BOARD_PRESET_COUNT];
+        options.boardWidth = preset.width;
+        options.boardHeight = preset.height;
+    }
+    else if (selected == ITEM_SPEED && (activate || IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_RIGHT)))
+    {
+        int step = IsKeyPressed(KEY_LEFT) ? SPEED_CURVE_COUNT - 1 : 1;
+        options.speedCurve = (options.speedCurve + step) % SPEED_CURVE_COUNT;
+    }
+    else if (selected == ITEM_BACK && activate)
+    {
+        game.PopScreen();
+    }
+}
+
+void OptionScreen::Draw(const Game &game)
+{
+    const int centerX = SCREEN_WIDTH / 2;
+
+    titleLabel.DrawCentered(centerX, SCREEN_HEIGHT / 4);
+
+    const StaticLabel *items[ITEM_COUNT] = {
+        game.Options().soundEnabled ? &soundOnLabel : &soundOffLabel,
+        &boardLabels[FindBoardPreset(game.Options())],
+        &speedLabels[game.Options().speedCurve],
+        &backLabel};
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        int y = SCREEN_HEIGHT / 2 + i * 50;
+        if (i == selected)
+        {
+            DrawRectangle(centerX - 160, y - 8, 320, 46, LIGHTGRAY); // 当前选中的选项
+        }
+        items[i]->DrawCentered(centerX, y);
+    }
+}
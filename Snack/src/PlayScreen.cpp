@@ -0,0 +1,254 @@
+#include "PlayScreen.h"
+#include "Audio.h"
+#include "Constants.h"
+#include "Game.h"
+#include "Profiler.h"
+#include <ctime>
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const char *const REPLAY_FILE = "last_game.snkr"; // 每局结束时覆盖, 可以用 Headless --replay 回放
+
+PlayScreen::PlayScreen(void)
+    : board(GAME_AREA_WIDTH, GAME_AREA_HEIGHT), useViewport(false), lastQueuedDir(DIR_RIGHT), speed(GetSpeedCurve(SPEED_CLASSIC)), foodEaten(0), alpha(1.0f), lastStep{}, paused(false), autopilotEnabled(false), autopilotUsed(false), playTime(0.0),
+      scoreText("Score: %i", 20), pausedLabel("PAUSED", 40, GRAY), autopilotLabel("AUTOPILOT", 20, DARKGRAY)
+{
+}
+
+void PlayScreen::Load(void)
+{
+    boardRenderer.Load(GAME_AREA_WIDTH, GAME_AREA_HEIGHT, SQUARE_SIZE);
+    viewportRenderer.Load(GAME_AREA_WIDTH, GAME_AREA_HEIGHT, SQUARE_SIZE); // 视口正好一屏
+    pausedLabel.Load();
+    autopilotLabel.Load();
+}
+
+void PlayScreen::Unload(void)
+{
+    autopilotLabel.Unload();
+    pausedLabel.Unload();
+    viewportRenderer.Unload();
+    boardRenderer.Unload();
+}
+
+void PlayScreen::Enter(Game &game)
+{
+    // 棋盘大小在选项里设置, 每次进入时读取 (大小不变时 Reset 不会重新分配)
+    const GameOptions &options = game.Options();
+    board = DynamicBoard(options.boardWidth, options.boardHeight);
+    useViewport = (board.Width() != GAME_AREA_WIDTH || board.Height() != GAME_AREA_HEIGHT);
+    speed = GetSpeedCurve((SpeedCurveId)options.speedCurve);
+    InitGame();
+}
+
+void PlayScreen::InitGame(void)
+{
+    paused = false;
+
+    // 随机种子来自 raylib, 之后的食物位置完全由 Simulation 自己决定
+    uint64_t seed = (uint64_t)GetRandomValue(0, 0x7fffffff);
+    if (useViewport)
+        BeginRound(sim, board, seed);
+    else
+        BeginRound(classicSim, ClassicBoard(), seed);
+    pendingTurns.Clear();
+    autopilotUsed = autopilotEnabled;
+    playTime = 0.0;
+    if (autopilotEnabled)
+        ResetAutopilot();
+
+    foodEaten = 0;
+    clock.Reset(SpeedInterval(speed, foodEaten));
+    alpha = 1.0f;
+    boardRenderer.Invalidate();
+}
+
+template <class Board>
+void PlayScreen::BeginRound(BasicSimulation<Board> &round, const Board &roundBoard, uint64_t seed)
+{
+    round.Reset(roundBoard, seed);
+    lastQueuedDir = round.Direction();
+    recorder.Begin(round.Width(), round.Height(), seed, 0, round.Direction());
+    lastStep = {};
+    lastStep.prevHead = round.GetSnake().Head().position;
+}
+
+void PlayScreen::ResetAutopilot(void)
+{
+    // 搜索数组和棋盘一样大, 只在打开时准备
+    if (useViewport)
+        autopilot.Reset(board, AUTOPILOT_BFS);
+    else
+        classicAutopilot.Reset(ClassicBoard(), AUTOPILOT_BFS);
+}
+
+void PlayScreen::HandleInput(void)
+{
+    // 按下的顺序读取本帧所有按键, 同一帧里的两次转向都不会丢
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed())
+    {
+        SnakeDirection dir;
+        switch (key)
+        {
+        case KEY_RIGHT:
+            dir = DIR_RIGHT;
+            break;
+        case KEY_LEFT:
+            dir = DIR_LEFT;
+            break;
+        case KEY_UP:
+            dir = DIR_UP;
+            break;
+        case KEY_DOWN:
+            dir = DIR_DOWN;
+            break;
+        default:
+            continue;
+        }
+        QueueTurn(dir);
+    }
+}
+
+void PlayScreen::QueueTurn(SnakeDirection dir)
+{
+    // 和最后排队的方向比较, 而不是和当前方向: 快速的 "上, 左" 在向右移动时是合法的两次转向
+    if (dir == lastQueuedDir || IsOpposite(dir, lastQueuedDir))
+        return;
+
+    if (pendingTurns.Push(dir))
+        lastQueuedDir = dir;
+}
+
+void PlayScreen::Update(Game &game, float frameTime)
+{
+    if (IsKeyPressed(KEY_ESCAPE))
+    {
+        game.ChangeScreen(SCREEN_MENU);
+        return;
+    }
+
+    if (IsKeyPressed(KEY_P))
+        paused = !paused;
+
+    if (IsKeyPressed(KEY_A))
+    {
+        autopilotEnabled = !autopilotEnabled;
+        if (autopilotEnabled)
+            ResetAutopilot();
+        autopilotUsed = autopilotUsed || autopilotEnabled;
+    }
+
+    if (paused)
+    {
+        // 暂停时按下的键不能在继续之后变成排队的转向: 清空 raylib 的按键队列
+        while (GetKeyPressed() != 0)
+        {
+        }
+        return;
+    }
+
+    // --- 处理输入 ---
+    HandleInput();
+
+    // --- 固定步长模拟: 按累计的时间跑 N 个 tick, 与帧率无关 ---
+    clock.Advance(frameTime);
+    playTime += frameTime;
+
+    const bool finished = useViewport ? RunTicks(game, sim, autopilot) : RunTicks(game, classicSim, classicAutopilot);
+    if (finished)
+        return;
+
+    // 追赶达到上限时丢弃积压的时间, 而不是在之后的帧里继续追
+    clock.DropBacklog();
+    alpha = clock.Alpha();
+}
+
+template <class Board>
+bool PlayScreen::RunTicks(Game &game, BasicSimulation<Board> &round, BasicAutopilot<Board> &pilot)
+{
+    int steps = 0;
+    while (steps < MAX_STEPS_PER_FRAME && clock.Consume()) // 保留余数, tick 频率不会随帧时间漂移
+    {
+        // 自动驾驶和键盘走同一个转向队列; 玩家排队的转向优先
+        if (autopilotEnabled && pendingTurns.Empty())
+            QueueTurn(pilot.Decide(round));
+
+        StepGame(round);
+        steps++;
+
+        if (!round.Running())
+        {
+            recorder.Finish(round.Ticks(), round.Score(), round.Status());
+            SaveReplay(REPLAY_FILE, recorder.GetReplay()); // 写不进去时只是没有录像, 不影响游戏
+            game.SetLastResult(round.Score(), round.Status() == SIM_WON, game.Stats().Record(MakeRecord(round)));
+            game.ChangeScreen(SCREEN_GAME_OVER);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class Board>
+GameRecord PlayScreen::MakeRecord(const BasicSimulation<Board> &round) const
+{
+    GameRecord record;
+    record.timestamp = (int64_t)time(nullptr);
+    record.ticks = round.Ticks();
+    record.score = round.Score();
+    record.length = (uint32_t)round.GetSnake().Size();
+    record.durationMillis = (uint32_t)(playTime * 1000.0 + 0.5);
+    record.width = (uint16_t)round.Width();
+    record.height = (uint16_t)round.Height();
+    record.status = round.Status();
+    record.autopilot = autopilotUsed;
+    return record;
+}
+
+template <class Board>
+void PlayScreen::StepGame(BasicSimulation<Board> &round)
+{
+    SNAKE_PROFILE_SCOPE(PROFILE_STEP);
+
+    // 每个 tick 最多消费一次转向, 队列为空时保持当前方向
+    SnakeDirection input = round.Direction();
+    pendingTurns.Pop(input);
+
+    StepResult result = round.Step(input);
+    recorder.RecordTick(round.Ticks(), round.Direction()); // 只有方向变化时才写入录像
+    if (!useViewport)
+        boardRenderer.Apply(round, result); // 只记录变化的格子
+
+    if (result.died)
+    {
+        PlayGameSound(SOUND_GAME_OVER);
+        return;
+    }
+    if (result.ateFood)
+    {
+        PlayGameSound(SOUND_EAT);
+        clock.SetInterval(SpeedInterval(speed, ++foodEaten)); // 间隔只在这里变化
+    }
+    lastStep = result;
+}
+
+void PlayScreen::Draw(const Game &)
+{
+    // 绘制网格, 蛇和食物 (draw call 数量固定, 与棋盘大小和蛇的长度无关)
+    // 一屏放不下的棋盘只画摄像机看到的部分
+    if (useViewport)
+        viewportRenderer.Draw(sim, lastStep, paused ? 1.0f : alpha);
+    else
+        boardRenderer.Draw(classicSim, lastStep, paused ? 1.0f : alpha);
+
+    // 绘制分数 (文字只在分数变化时重新格式化)
+    scoreText.Set(useViewport ? sim.Score() : classicSim.Score());
+    scoreText.Draw(10, 10, BLACK);
+    if (autopilotEnabled)
+        autopilotLabel.Draw(SCREEN_WIDTH - autopilotLabel.Width() - 10, 10);
+
+    if (paused)
+    {
+        pausedLabel.DrawCentered(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20);
+    }
+}
@@ -0,0 +1,5 @@
+#include "Prediction.h"
+
+// 常用棋盘的显式实例化, 其它 FixedBoard 在使用处按需实例化
+template class BasicPredictor<DynamicBoard>;
+template class BasicPredictor<ClassicBoard>;
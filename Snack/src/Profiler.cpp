@@ -0,0 +1,218 @@
+#include "Profiler.h"
+
+#ifdef SNAKE_ENABLE_PROFILER
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h> // _aligned_malloc
+#endif
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const char *const SECTION_NAMES[PROFILE_COUNT] = {
+    "frame",
+    "update",
+    "step",
+    "spawn_food",
+    "draw",
+};
+
+struct SectionStats
+{
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> totalNs;
+    std::atomic<uint64_t> maxNs;
+    std::atomic<uint32_t> buckets[PROFILE_BUCKET_COUNT];
+};
+
+// ------------------------------------------------------------------------------------
+// Module Variables
+// ------------------------------------------------------------------------------------
+static SectionStats sections[PROFILE_COUNT]; // 静态存储, 初始为 0
+static std::atomic<uint64_t> allocationCount(0);
+static uint64_t frameStartAllocations = 0;
+static uint64_t frameAllocations = 0;
+
+// ------------------------------------------------------------------------------------
+// Histogram
+// ------------------------------------------------------------------------------------
+static double Percentile(const SectionStats &stats, uint64_t count, double fraction)
+{
+    uint64_t rank = (uint64_t)(fraction * (double)(count - 1)) + 1; // 第 rank 个样本 (从 1 开始)
+    uint64_t seen = 0;
+    for (int i = 0; i < PROFILE_BUCKET_COUNT; i++)
+    {
+        seen += stats.buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            double low, high;
+            ProfileBucketBounds(i, low, high);
+            return (low + high) * 0.5; // 取桶的中点
+        }
+    }
+    return (double)stats.maxNs.load(std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------
+// Module Functions Implementation
+// ------------------------------------------------------------------------------------
+void ProfileRecord(ProfileSection section, uint64_t nanoseconds)
+{
+    SectionStats &stats = sections[section];
+    stats.count.fetch_add(1, std::memory_order_relaxed);
+    stats.totalNs.fetch_add(nanoseconds, std::memory_order_relaxed);
+    stats.buckets[ProfileBucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t previous = stats.maxNs.load(std::memory_order_relaxed);
+    while (nanoseconds > previous && !stats.maxNs.compare_exchange_weak(previous, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+ProfileSummary GetProfileSummary(ProfileSection section)
+{
+    const SectionStats &stats = sections[section];
+    ProfileSummary summary = {};
+    summary.name = SECTION_NAMES[section];
+    summary.count = stats.count.load(std::memory_order_relaxed);
+    if (summary.count == 0)
+        return summary;
+
+    // 直方图给出的是桶的中点, 不超过精确的最大值
+    double maxNs = (double)stats.maxNs.load(std::memory_order_relaxed);
+    double p50 = Percentile(stats, summary.count, 0.50);
+    double p99 = Percentile(stats, summary.count, 0.99);
+    summary.totalUs = (double)stats.totalNs.load(std::memory_order_relaxed) / 1000.0;
+    summary.meanUs = summary.totalUs / (double)summary.count;
+    summary.p50Us = (p50 < maxNs ? p50 : maxNs) / 1000.0;
+    summary.p99Us = (p99 < maxNs ? p99 : maxNs) / 1000.0;
+    summary.maxUs = maxNs / 1000.0;
+    return summary;
+}
+
+void ResetProfile(void)
+{
+    for (SectionStats &stats : sections)
+    {
+        stats.count.store(0, std::memory_order_relaxed);
+        stats.totalNs.store(0, std::memory_order_relaxed);
+        stats.maxNs.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint32_t> &bucket : stats.buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t GetAllocationCount(void)
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t GetFrameAllocationCount(void)
+{
+    return frameAllocations;
+}
+
+void ProfileFrameEnd(void)
+{
+    uint64_t now = GetAllocationCount();
+    frameAllocations = now - frameStartAllocations;
+    frameStartAllocations = now;
+}
+
+bool SaveProfileCsv(const char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == nullptr)
+        return false;
+
+    fprintf(file, "section,count,total_us,mean_us,p50_us,p99_us,max_us\n");
+    for (int i = 0; i < PROFILE_COUNT; i++)
+    {
+        ProfileSummary s = GetProfileSummary((ProfileSection)i);
+        fprintf(file, "%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f\n", s.name, (unsigned long long)s.count, s.totalUs, s.meanUs,
+                s.p50Us, s.p99Us, s.maxUs);
+    }
+    fprintf(file, "allocations,%llu,,,,,\n", (unsigned long long)GetAllocationCount());
+    return fclose(file) == 0;
+}
+
+bool SaveProfileJson(const char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == nullptr)
+        return false;
+
+    fprintf(file, "{\n  \"allocations\": %llu,\n  \"sections\": {\n", (unsigned long long)GetAllocationCount());
+    for (int i = 0; i < PROFILE_COUNT; i++)
+    {
+        ProfileSummary s = GetProfileSummary((ProfileSection)i);
+        fprintf(file,
+                "    \"%s\": {\"count\": %llu, \"total_us\": %.3f, \"mean_us\": %.3f, \"p50_us\": %.3f, "
+                "\"p99_us\": %.3f, \"max_us\": %.3f}%s\n",
+                s.name, (unsigned long long)s.count, s.totalUs, s.meanUs, s.p50Us, s.p99Us, s.maxUs,
+                (i + 1 < PROFILE_COUNT) ? "," : "");
+    }
+    fprintf(file, "  }\n}\n");
+    return fclose(file) == 0;
+}
+
+// ------------------------------------------------------------------------------------
+// Allocation Counting
+// 只替换最基本的几个版本; 数组版本和 nothrow 版本默认转发到这里
+// ------------------------------------------------------------------------------------
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size != 0 ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+// alignas(64) 的 Simulation 放进 vector 时走对齐版本
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = (std::size_t)alignment;
+#ifdef _WIN32
+    void *memory = _aligned_malloc(size != 0 ? size : 1, align);
+#else
+    std::size_t rounded = ((size != 0 ? size : 1) + align - 1) / align * align; // aligned_alloc 要求整数倍
+    void *memory = std::aligned_alloc(align, rounded);
+#endif
+    if (memory != nullptr)
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+void operator delete(void *memory, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(memory, alignment);
+}
+
+#endif
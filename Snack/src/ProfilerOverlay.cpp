@@ -0,0 +1,68 @@
+#include "Profiler.h"
+
+#ifdef SNAKE_ENABLE_PROFILER
+
+#include "raylib.h"
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const int OVERLAY_X = 10;
+static const int OVERLAY_Y = 40;
+static const int LINE_HEIGHT = 14;
+static const int FONT_SIZE = 10;
+static const int COLUMN_X[5] = {0, 90, 160, 240, 320}; // 默认字体不是等宽的, 每一列单独定位
+
+// ------------------------------------------------------------------------------------
+// Module Variables
+// ------------------------------------------------------------------------------------
+static bool overlayVisible = false;
+
+// ------------------------------------------------------------------------------------
+// Module Functions Implementation
+// ------------------------------------------------------------------------------------
+void UpdateProfilerOverlay(void)
+{
+    if (IsKeyPressed(KEY_F3))
+        overlayVisible = !overlayVisible;
+
+    if (IsKeyPressed(KEY_F4))
+    {
+        bool saved = SaveProfileCsv("profile.csv") && SaveProfileJson("profile.json");
+        TraceLog(saved ? LOG_INFO : LOG_WARNING, "PROFILER: %s profile.csv / profile.json", saved ? "saved" : "failed to save");
+    }
+}
+
+void DrawProfilerOverlay(void)
+{
+    if (!overlayVisible)
+        return;
+
+    const int lineCount = PROFILE_COUNT + 2;
+    DrawRectangle(OVERLAY_X - 4, OVERLAY_Y - 4, 420, lineCount * LINE_HEIGHT + 8, Fade(BLACK, 0.7f));
+
+    int y = OVERLAY_Y;
+    const char *const headers[5] = {"section", "count", "p50 us", "p99 us", "max us"};
+    for (int c = 0; c < 5; c++)
+    {
+        DrawText(headers[c], OVERLAY_X + COLUMN_X[c], y, FONT_SIZE, LIGHTGRAY);
+    }
+    y += LINE_HEIGHT;
+
+    for (int i = 0; i < PROFILE_COUNT; i++)
+    {
+        ProfileSummary s = GetProfileSummary((ProfileSection)i);
+        DrawText(s.name, OVERLAY_X + COLUMN_X[0], y, FONT_SIZE, RAYWHITE);
+        DrawText(TextFormat("%llu", (unsigned long long)s.count), OVERLAY_X + COLUMN_X[1], y, FONT_SIZE, RAYWHITE);
+        DrawText(TextFormat("%.1f", s.p50Us), OVERLAY_X + COLUMN_X[2], y, FONT_SIZE, RAYWHITE);
+        DrawText(TextFormat("%.1f", s.p99Us), OVERLAY_X + COLUMN_X[3], y, FONT_SIZE, RAYWHITE);
+        DrawText(TextFormat("%.1f", s.maxUs), OVERLAY_X + COLUMN_X[4], y, FONT_SIZE, RAYWHITE);
+        y += LINE_HEIGHT;
+    }
+
+    DrawText(TextFormat("allocations: %llu last frame, %llu total (F4 saves profile.csv/json)",
+                        (unsigned long long)GetFrameAllocationCount(), (unsigned long long)GetAllocationCount()),
+             OVERLAY_X, y, FONT_SIZE, YELLOW);
+}
+
+#endif
@@ -0,0 +1,223 @@
+#include "Replay.h"
+#include <cstdio>
+#include <cstring>
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const char REPLAY_MAGIC[4] = {'S', 'N', 'K', 'R'};
+static const uint8_t REPLAY_VERSION = 1;
+
+// ------------------------------------------------------------------------------------
+// Encoding Helpers
+// ------------------------------------------------------------------------------------
+static void WriteVarint(std::vector<uint8_t> &bytes, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        bytes.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back((uint8_t)value);
+}
+
+// 越界或超过 10 字节时返回 false
+static bool ReadVarint(const std::vector<uint8_t> &bytes, size_t &offset, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (offset >= bytes.size())
+            return false;
+
+        uint8_t byte = bytes[offset++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+// 固定宽度的小端整数
+static void PutLittle(uint8_t *out, uint64_t value, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint64_t GetLittle(const uint8_t *in, int size)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < size; i++)
+    {
+        value |= (uint64_t)in[i] << (8 * i);
+    }
+    return value;
+}
+
+// 从当前位置到文件结尾的字节数, 读不出大小时为 0
+static uint64_t RemainingBytes(FILE *file)
+{
+    const long position = ftell(file);
+    if (position < 0 || fseek(file, 0, SEEK_END) != 0)
+        return 0;
+
+    const long end = ftell(file);
+    if (fseek(file, position, SEEK_SET) != 0 || end < position)
+        return 0;
+    return (uint64_t)(end - position);
+}
+
+static const int HEADER_SIZE = 4 + 1 + 2 + 2 + 8 + 8 + 8 + 4 + 1 + 4 + 4;
+
+// ------------------------------------------------------------------------------------
+// File IO
+// ------------------------------------------------------------------------------------
+bool SaveReplay(const char *fileName, const Replay &replay)
+{
+    uint8_t header[HEADER_SIZE];
+    uint8_t *out = header;
+    memcpy(out, REPLAY_MAGIC, 4);
+    out += 4;
+    *out++ = REPLAY_VERSION;
+    PutLittle(out, (uint64_t)replay.width, 2);
+    out += 2;
+    PutLittle(out, (uint64_t)replay.height, 2);
+    out += 2;
+    PutLittle(out, replay.seed, 8);
+    out += 8;
+    PutLittle(out, replay.stream, 8);
+    out += 8;
+    PutLittle(out, replay.tickCount, 8);
+    out += 8;
+    PutLittle(out, (uint32_t)replay.score, 4);
+    out += 4;
+    *out++ = (uint8_t)replay.status;
+    PutLittle(out, replay.eventCount, 4);
+    out += 4;
+    PutLittle(out, (uint64_t)replay.events.size(), 4);
+
+    FILE *file = fopen(fileName, "wb");
+    if (file == nullptr)
+        return false;
+
+    bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    if (ok && !replay.events.empty())
+        ok = fwrite(replay.events.data(), 1, replay.events.size(), file) == replay.events.size();
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
+
+bool LoadReplay(const char *fileName, Replay &replay)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (file == nullptr)
+        return false;
+
+    uint8_t header[HEADER_SIZE];
+    bool ok = fread(header, 1, sizeof(header), file) == sizeof(header) && memcmp(header, REPLAY_MAGIC, 4) == 0 &&
+              header[4] == REPLAY_VERSION;
+    if (ok)
+    {
+        const uint8_t *in = header + 5;
+        replay.width = (int)GetLittle(in, 2);
+        replay.height = (int)GetLittle(in + 2, 2);
+        replay.seed = GetLittle(in + 4, 8);
+        replay.stream = GetLittle(in + 12, 8);
+        replay.tickCount = GetLittle(in + 20, 8);
+        replay.score = (int32_t)(uint32_t)GetLittle(in + 28, 4);
+        replay.status = (SimStatus)in[32];
+        replay.eventCount = (uint32_t)GetLittle(in + 33, 4);
+
+        // 不让文件头决定分配多大: 回放时按棋盘大小分配蛇身, 位图和空闲格子, 所以每边不超过
+        // MAX_BOARD_SIZE; 事件的字节数不能超过文件里剩下的部分
+        const uint64_t byteCount = GetLittle(in + 37, 4);
+        ok = replay.width >= 3 && replay.height >= 1 && replay.width <= MAX_BOARD_SIZE &&
+             replay.height <= MAX_BOARD_SIZE && replay.status <= SIM_WON && byteCount <= RemainingBytes(file);
+        if (ok)
+        {
+            replay.events.resize((size_t)byteCount);
+            ok = replay.events.empty() ||
+                 fread(replay.events.data(), 1, replay.events.size(), file) == replay.events.size();
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
+// ------------------------------------------------------------------------------------
+// Recording
+// ------------------------------------------------------------------------------------
+ReplayRecorder::ReplayRecorder(void) : replay{}, lastEventTick(0), lastDirection(DIR_RIGHT)
+{
+}
+
+void ReplayRecorder::Begin(int width, int height, uint64_t seed, uint64_t stream, SnakeDirection initialDirection)
+{
+    replay.width = width;
+    replay.height = height;
+    replay.seed = seed;
+    replay.stream = stream;
+    replay.tickCount = 0;
+    replay.score = 0;
+    replay.status = SIM_RUNNING;
+    replay.eventCount = 0;
+    replay.events.clear(); // 保留容量, 重新开始时通常不需要再分配
+    if (replay.events.capacity() < 1024)
+        replay.events.reserve(1024);
+
+    lastEventTick = 0;
+    lastDirection = initialDirection;
+}
+
+void ReplayRecorder::RecordTick(uint64_t tick, SnakeDirection direction)
+{
+    replay.tickCount = tick;
+    if (direction == lastDirection)
+        return;
+
+    WriteVarint(replay.events, ((tick - lastEventTick) << 2) | (uint64_t)direction);
+    replay.eventCount++;
+    lastEventTick = tick;
+    lastDirection = direction;
+}
+
+void ReplayRecorder::Finish(uint64_t tickCount, int score, SimStatus status)
+{
+    replay.tickCount = tickCount;
+    replay.score = score;
+    replay.status = status;
+}
+
+// ------------------------------------------------------------------------------------
+// Playback
+// ------------------------------------------------------------------------------------
+void ReplayCursor::Begin(const Replay &replay)
+{
+    offset = 0;
+    lastTick = 0;
+    Advance(replay);
+}
+
+void ReplayCursor::Advance(const Replay &replay)
+{
+    uint64_t value;
+    if (!ReadVarint(replay.events, offset, value) || (value >> 2) == 0)
+    {
+        // 没有更多事件 (或者数据损坏): 之后一直保持当前方向
+        nextTick = 0;
+        nextDirection = DIR_RIGHT;
+        offset = replay.events.size();
+        return;
+    }
+
+    lastTick += value >> 2;
+    nextTick = lastTick;
+    nextDirection = (SnakeDirection)(value & 3);
+}
+
+// 常用棋盘的显式实例化
+template class BasicReplayPlayer<DynamicBoard>;
+template class BasicReplayPlayer<ClassicBoard>;
@@ -0,0 +1,5 @@
+#include "Snacke.h"
+
+// 常用棋盘的显式实例化, 其它 FixedBoard 在使用处按需实例化
+template class BasicSnake<DynamicBoard>;
+template class BasicSnake<ClassicBoard>;
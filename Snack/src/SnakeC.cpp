@@ -0,0 +1,183 @@
+#include "SnakeC.h"
+#include "BatchEnv.h"
+#include <cstddef>
+#include <cstring>
+
+// SnakeStepInfo 就是 EnvStepInfo, 调用方的缓冲区可以直接交给 BatchEnv 写
+static_assert(sizeof(SnakeStepInfo) == sizeof(EnvStepInfo), "step info layout mismatch");
+static_assert(offsetof(SnakeStepInfo, reward) == offsetof(EnvStepInfo, reward), "step info layout mismatch");
+static_assert(offsetof(SnakeStepInfo, done) == offsetof(EnvStepInfo, done), "step info layout mismatch");
+static_assert(offsetof(SnakeStepInfo, won) == offsetof(EnvStepInfo, won), "step info layout mismatch");
+static_assert(offsetof(SnakeStepInfo, episodeScore) == offsetof(EnvStepInfo, episodeScore), "step info layout mismatch");
+static_assert(offsetof(SnakeStepInfo, episodeTicks) == offsetof(EnvStepInfo, episodeTicks), "step info layout mismatch");
+
+// ------------------------------------------------------------------------------------
+// Environment Wrapper
+// 40x30 走编译期棋盘, 其它大小走 DynamicBoard; 对外是同一个不透明类型
+// ------------------------------------------------------------------------------------
+struct SnakeEnv
+{
+    virtual ~SnakeEnv(void) {}
+    virtual int Count(void) const = 0;
+    virtual int Width(void) const = 0;
+    virtual int Height(void) const = 0;
+    virtual void Reset(const SnakeObservation *observation) = 0;
+    virtual void Step(const int32_t *actions, SnakeStepInfo *infos, const SnakeObservation *observation) = 0;
+    virtual void Observe(const SnakeObservation *observation) = 0;
+};
+
+template <class Board>
+static void WriteObservation(const SnakeObservation &observation, int index, const BasicSimulation<Board> &game)
+{
+    const auto &snake = game.GetSnake();
+    const Food &food = game.GetFood();
+    const Cell head = snake.Head().position;
+
+    if (observation.grid != nullptr)
+    {
+        // 整块网格先 memset 清空 (和格子数成正比, 但只是一次顺序写), 再只写蛇身和食物,
+        // 不逐格查询占用位图
+        const Board &board = game.GetBoard();
+        uint8_t *grid = observation.grid + (size_t)index * (size_t)board.CellCount();
+        memset(grid, SNAKE_CELL_EMPTY, (size_t)board.CellCount());
+        for (size_t i = 1; i < snake.Size(); i++)
+        {
+            grid[board.Index(snake[i].position)] = SNAKE_CELL_BODY;
+        }
+        grid[board.Index(head)] = SNAKE_CELL_HEAD;
+        if (food.active)
+            grid[board.Index(food.position)] = SNAKE_CELL_FOOD;
+    }
+    if (observation.heads != nullptr)
+    {
+        observation.heads[2 * index] = head.x;
+        observation.heads[2 * index + 1] = head.y;
+    }
+    if (observation.foods != nullptr)
+    {
+        observation.foods[2 * index] = food.active ? food.position.x : (int16_t)-1;
+        observation.foods[2 * index + 1] = food.active ? food.position.y : (int16_t)-1;
+    }
+    if (observation.lengths != nullptr)
+    {
+        observation.lengths[index] = (int32_t)snake.Size();
+    }
+}
+
+template <class Board>
+class SnakeEnvImpl : public SnakeEnv
+{
+public:
+    SnakeEnvImpl(int count, const Board &board, uint32_t seed, int threads)
+        : env(count, board, seed, threads), actionBuffer((size_t)count)
+    {
+    }
+
+    int Count(void) const override { return env.Size(); }
+    int Width(void) const override { return env.GetBoard().Width(); }
+    int Height(void) const override { return env.GetBoard().Height(); }
+
+    void Reset(const SnakeObservation *observation) override
+    {
+        env.Reset();
+        Observe(observation);
+    }
+
+    void Step(const int32_t *actions, SnakeStepInfo *infos, const SnakeObservation *observation) override
+    {
+        // 只保留低 2 位, 越界的输入不会变成非法的方向 (缓冲区在创建时分配好)
+        for (int i = 0; i < env.Size(); i++)
+        {
+            actionBuffer[i] = (SnakeDirection)(actions[i] & 3);
+        }
+
+        EnvStepInfo *out = reinterpret_cast<EnvStepInfo *>(infos);
+        if (observation == nullptr)
+        {
+            env.Step(actionBuffer.data(), out);
+            return;
+        }
+
+        const SnakeObservation target = *observation;
+        env.Step(actionBuffer.data(), out,
+                 [&target](int index, const BasicSimulation<Board> &game) { WriteObservation(target, index, game); });
+    }
+
+    void Observe(const SnakeObservation *observation) override
+    {
+        if (observation == nullptr)
+            return;
+
+        const SnakeObservation target = *observation;
+        env.Observe([&target](int index, const BasicSimulation<Board> &game) { WriteObservation(target, index, game); });
+    }
+
+private:
+    BasicBatchEnv<Board> env;
+    std::vector<SnakeDirection> actionBuffer;
+};
+
+// ------------------------------------------------------------------------------------
+// C API
+// ------------------------------------------------------------------------------------
+int SnakeVersion(void)
+{
+    return SNAKE_C_VERSION;
+}
+
+SnakeEnv *SnakeEnvCreate(int32_t count, int32_t width, int32_t height, uint32_t seed, int32_t threads)
+{
+    if (count <= 0 || width < 3 || height < 1 || width > MAX_BOARD_SIZE || height > MAX_BOARD_SIZE || threads < 0)
+        return nullptr;
+
+    // 异常不能穿过 C ABI: 分配失败 (bad_alloc) 或者线程池建不了线程 (system_error) 时都返回 NULL
+    try
+    {
+        if (width == GAME_AREA_WIDTH && height == GAME_AREA_HEIGHT)
+            return new SnakeEnvImpl<ClassicBoard>(count, ClassicBoard(), seed, threads);
+        return new SnakeEnvImpl<DynamicBoard>(count, DynamicBoard(width, height), seed, threads);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void SnakeEnvDestroy(SnakeEnv *env)
+{
+    delete env;
+}
+
+int32_t SnakeEnvCount(const SnakeEnv *env)
+{
+    return env->Count();
+}
+
+int32_t SnakeEnvWidth(const SnakeEnv *env)
+{
+    return env->Width();
+}
+
+int32_t SnakeEnvHeight(const SnakeEnv *env)
+{
+    return env->Height();
+}
+
+void SnakeEnvReset(SnakeEnv *env, const SnakeObservation *observation)
+{
+    env->Reset(observation);
+}
+
+int SnakeEnvStep(SnakeEnv *env, const int32_t *actions, SnakeStepInfo *infos, const SnakeObservation *observation)
+{
+    if (env == nullptr || actions == nullptr || infos == nullptr)
+        return -1;
+
+    env->Step(actions, infos, observation);
+    return 0;
+}
+
+void SnakeEnvObserve(SnakeEnv *env, const SnakeObservation *observation)
+{
+    env->Observe(observation);
+}
@@ -0,0 +1,17 @@
+#include "Speed.h"
+#include "Constants.h"
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const SpeedCurve SPEED_CURVES[SPEED_CURVE_COUNT] = {
+    {MOVE_INTERVAL_MICROS, MOVE_INTERVAL_MICROS, 0, 1, "Speed: Classic"},
+    {MOVE_INTERVAL_MICROS, 60000, 5000, 2, "Speed: Gentle"},
+    {100000, 20000, 5000, 1, "Speed: Fast"},
+    {40000, 5000, 1000, 1, "Speed: Insane"},
+};
+
+const SpeedCurve &GetSpeedCurve(SpeedCurveId id)
+{
+    return SPEED_CURVES[(id >= 0 && id < SPEED_CURVE_COUNT) ? id : SPEED_CLASSIC];
+}
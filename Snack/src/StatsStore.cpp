@@ -0,0 +1,234 @@
+#include "StatsStore.h"
+#include <cstring>
+
+// ------------------------------------------------------------------------------------
+// Module Defines
+// ------------------------------------------------------------------------------------
+static const char STATS_MAGIC[4] = {'S', 'N', 'K', 'S'};
+static const uint8_t STATS_VERSION = 1;
+static const int HEADER_SIZE = 8;
+static const int RECORD_SIZE = 8 + 8 + 4 + 4 + 4 + 2 + 2 + 1 + 1 + 2 + 4;
+static const int CHECKSUM_OFFSET = RECORD_SIZE - 4;
+static const uint8_t FLAG_AUTOPILOT = 0x01;
+
+static void PutLittle(uint8_t *out, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint64_t GetLittle(const uint8_t *in, int bytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++)
+    {
+        value |= (uint64_t)in[i] << (8 * i);
+    }
+    return value;
+}
+
+// FNV-1a, 只用来发现写了一半或者被改坏的记录
+static uint32_t Checksum(const uint8_t *data, int size)
+{
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void EncodeRecord(const GameRecord &record, uint8_t *out)
+{
+    PutLittle(out, (uint64_t)record.timestamp, 8);
+    PutLittle(out + 8, record.ticks, 8);
+    PutLittle(out + 16, (uint32_t)record.score, 4);
+    PutLittle(out + 20, record.length, 4);
+    PutLittle(out + 24, record.durationMillis, 4);
+    PutLittle(out + 28, record.width, 2);
+    PutLittle(out + 30, record.height, 2);
+    out[32] = (uint8_t)record.status;
+    out[33] = record.autopilot ? FLAG_AUTOPILOT : 0;
+    PutLittle(out + 34, 0, 2);
+    PutLittle(out + CHECKSUM_OFFSET, Checksum(out, CHECKSUM_OFFSET), 4);
+}
+
+static bool DecodeRecord(const uint8_t *in, GameRecord &record)
+{
+    if ((uint32_t)GetLittle(in + CHECKSUM_OFFSET, 4) != Checksum(in, CHECKSUM_OFFSET) || in[32] > SIM_WON)
+        return false;
+
+    record.timestamp = (int64_t)GetLittle(in, 8);
+    record.ticks = GetLittle(in + 8, 8);
+    record.score = (int32_t)(uint32_t)GetLittle(in + 16, 4);
+    record.length = (uint32_t)GetLittle(in + 20, 4);
+    record.durationMillis = (uint32_t)GetLittle(in + 24, 4);
+    record.width = (uint16_t)GetLittle(in + 28, 2);
+    record.height = (uint16_t)GetLittle(in + 30, 2);
+    record.status = (SimStatus)in[32];
+    record.autopilot = (in[33] & FLAG_AUTOPILOT) != 0;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------
+// StatsStore
+// ------------------------------------------------------------------------------------
+StatsStore::StatsStore(void)
+    : leaderboard{}, leaderboardCount(0), gamesPlayed(0), totalTicks(0), totalMillis(0), bestLength(0), dropped(0),
+      file(nullptr), stopping(false), writeFailures(0)
+{
+}
+
+void StatsStore::Open(const char *fileName)
+{
+    Close();
+    leaderboardCount = 0;
+    gamesPlayed = 0;
+    totalTicks = 0;
+    totalMillis = 0;
+    bestLength = 0;
+    dropped = 0;
+    writeFailures.store(0);
+
+    // 读一遍已有的日志; 校验和不对的记录跳过, 最后不完整的半条记录会被下一条覆盖
+    long appendAt = HEADER_SIZE;
+    file = fopen(fileName, "r+b");
+    if (file != nullptr)
+    {
+        uint8_t header[HEADER_SIZE];
+        if (fread(header, 1, sizeof(header), file) != sizeof(header) || memcmp(header, STATS_MAGIC, 4) != 0 ||
+            header[4] != STATS_VERSION)
+        {
+            // 不是我们的文件 (或者是以后的版本): 不去碰它, 只在内存里统计
+            fclose(file);
+            file = nullptr;
+            return;
+        }
+
+        uint8_t buffer[RECORD_SIZE];
+        while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+        {
+            GameRecord record;
+            if (DecodeRecord(buffer, record))
+                Index(record);
+            appendAt += RECORD_SIZE;
+        }
+        if (fseek(file, appendAt, SEEK_SET) != 0)
+        {
+            fclose(file);
+            file = nullptr;
+        }
+    }
+    else
+    {
+        file = fopen(fileName, "wb");
+        uint8_t header[HEADER_SIZE] = {};
+        memcpy(header, STATS_MAGIC, 4);
+        header[4] = STATS_VERSION;
+        if (file != nullptr && (fwrite(header, 1, sizeof(header), file) != sizeof(header) || fflush(file) != 0))
+        {
+            fclose(file);
+            file = nullptr;
+        }
+    }
+
+    if (file == nullptr)
+        return;
+
+    stopping.store(false);
+    writer = std::thread(&StatsStore::WriterMain, this);
+}
+
+void StatsStore::Close(void)
+{
+    if (writer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping.store(true);
+        }
+        wake.notify_one();
+        writer.join();
+    }
+    if (file != nullptr)
+    {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+int StatsStore::Record(const GameRecord &record)
+{
+    int rank = Index(record);
+    if (!writer.joinable())
+        return rank;
+
+    if (!pending.Push(record))
+    {
+        dropped++;
+        return rank;
+    }
+
+    // 锁只用来避免错过唤醒, 写入线程写盘时不持有它
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_one();
+    return rank;
+}
+
+int StatsStore::Index(const GameRecord &record)
+{
+    gamesPlayed++;
+    totalTicks += record.ticks;
+    totalMillis += record.durationMillis;
+    if (record.length > bestLength)
+        bestLength = record.length;
+
+    if (record.autopilot)
+        return -1;
+
+    int rank = 0;
+    while (rank < leaderboardCount && (leaderboard[rank].score > record.score ||
+                                       (leaderboard[rank].score == record.score && leaderboard[rank].ticks <= record.ticks)))
+    {
+        rank++;
+    }
+    if (rank == LEADERBOARD_SIZE)
+        return -1;
+
+    if (leaderboardCount < LEADERBOARD_SIZE)
+        leaderboardCount++;
+    for (int i = leaderboardCount - 1; i > rank; i--)
+    {
+        leaderboard[i] = leaderboard[i - 1];
+    }
+    leaderboard[rank] = record;
+    return rank;
+}
+
+void StatsStore::WriterMain(void)
+{
+    uint8_t buffer[RECORD_SIZE];
+    for (;;)
+    {
+        GameRecord record;
+        bool wrote = false;
+        while (pending.Pop(record))
+        {
+            EncodeRecord(record, buffer);
+            if (fwrite(buffer, 1, sizeof(buffer), file) != sizeof(buffer))
+                writeFailures++;
+            wrote = true;
+        }
+        if (wrote && fflush(file) != 0)
+            writeFailures++;
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        if (stopping.load() && pending.Empty())
+            break;
+        wake.wait(lock, [this] { return stopping.load() || !pending.Empty(); });
+    }
+}
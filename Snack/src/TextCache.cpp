@@ -0,0 +1,51 @@
+#include "TextCache.h"
+#include <cstdio>
+
+// ------------------------------------------------------------------------------------
+// CachedNumberText
+// ------------------------------------------------------------------------------------
+CachedNumberText::CachedNumberText(const char *textFormat, int textFontSize)
+    : format(textFormat), fontSize(textFontSize), value(0), valid(false), width(0), text{}
+{
+}
+
+void CachedNumberText::Set(int newValue)
+{
+    if (valid && newValue == value)
+        return;
+
+    value = newValue;
+    valid = true;
+    snprintf(text, sizeof(text), format, value);
+    width = MeasureText(text, fontSize);
+}
+
+// ------------------------------------------------------------------------------------
+// StaticLabel
+// ------------------------------------------------------------------------------------
+StaticLabel::StaticLabel(const char *labelText, int labelFontSize, Color labelColor)
+    : text(labelText), fontSize(labelFontSize), color(labelColor), width(0), texture{}
+{
+}
+
+void StaticLabel::Load(void)
+{
+    width = MeasureText(text, fontSize);
+    texture = LoadRenderTexture(width, fontSize);
+
+    BeginTextureMode(texture);
+    ClearBackground(BLANK);
+    DrawText(text, 0, 0, fontSize, color);
+    EndTextureMode();
+}
+
+void StaticLabel::Unload(void)
+{
+    UnloadRenderTexture(texture);
+}
+
+void StaticLabel::Draw(int x, int y) const
+{
+    // RenderTexture 的纹理是上下颠倒的, 源矩形高度取负
+    DrawTextureRec(texture.texture, {0, 0, (float)width, -(float)fontSize}, {(float)x, (float)y}, WHITE);
+}
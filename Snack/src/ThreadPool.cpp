@@ -0,0 +1,95 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount)
+    : generation(0), pending(0), stopping(false), job(nullptr), jobContext(nullptr), jobCount(0), jobGrain(1), nextChunk(0)
+{
+    if (threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency();
+    if (threadCount <= 0)
+        threadCount = 1;
+
+    // 调用线程自己也干活, 所以只需要额外启动 threadCount - 1 个线程
+    workers.reserve(threadCount - 1);
+    for (int i = 1; i < threadCount; i++)
+    {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::Run(JobFunction function, void *context, int count, int grain)
+{
+    if (grain < 1)
+        grain = 1;
+
+    // 工作量不够分的时候直接在调用线程上做完
+    if (workers.empty() || count <= grain)
+    {
+        if (count > 0)
+            function(context, 0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = function;
+        jobContext = context;
+        jobCount = count;
+        jobGrain = grain;
+        nextChunk.store(0, std::memory_order_relaxed);
+        pending = (int)workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    RunChunks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return pending == 0; });
+}
+
+void ThreadPool::RunChunks(void)
+{
+    for (;;)
+    {
+        int begin = nextChunk.fetch_add(1, std::memory_order_relaxed) * jobGrain;
+        if (begin >= jobCount)
+            break;
+
+        int end = (begin + jobGrain < jobCount) ? begin + jobGrain : jobCount;
+        job(jobContext, begin, end);
+    }
+}
+
+void ThreadPool::WorkerLoop(void)
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+
+        RunChunks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0)
+            finished.notify_one();
+    }
+}
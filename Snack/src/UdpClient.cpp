@@ -0,0 +1,96 @@
+#include "UdpClient.h"
+#include <cstring>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int SocketLength;
+#define CloseSocket closesocket
+#else
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef ssize_t SocketLength;
+#define CloseSocket close
+#endif
+
+// Open 在 WSAStartup 之后失败时调用: handle 仍然是 -1, Close 不会再去平衡这一次 WSAStartup
+static bool OpenFailed(void)
+{
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+    return false;
+}
+
+bool UdpClient::Open(const char *host, uint16_t port)
+{
+    Close();
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+        return false;
+#endif
+
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo *found = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &found) != 0 || found == nullptr)
+        return OpenFailed();
+
+    sockaddr_in address;
+    memcpy(&address, found->ai_addr, sizeof(address));
+    address.sin_port = htons(port);
+    freeaddrinfo(found);
+
+    auto fd = socket(AF_INET, SOCK_DGRAM, 0);
+#if defined(_WIN32)
+    if (fd == INVALID_SOCKET)
+        return OpenFailed();
+    u_long nonBlocking = 1;
+    bool ok = ioctlsocket(fd, FIONBIO, &nonBlocking) == 0;
+#else
+    if (fd < 0)
+        return OpenFailed();
+    bool ok = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+    if (!ok || connect(fd, (const sockaddr *)&address, sizeof(address)) != 0)
+    {
+        CloseSocket(fd);
+        return OpenFailed();
+    }
+
+    handle = (intptr_t)fd;
+    return true;
+}
+
+void UdpClient::Close(void)
+{
+    if (handle == -1)
+        return;
+
+    CloseSocket(handle);
+    handle = -1;
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+}
+
+bool UdpClient::Send(const uint8_t *data, size_t size)
+{
+    if (handle == -1)
+        return false;
+    return send(handle, (const char *)data, (int)size, 0) == (SocketLength)size;
+}
+
+int UdpClient::Receive(uint8_t *out, size_t capacity)
+{
+    if (handle == -1)
+        return -1;
+    // ICMP 端口不可达 (服务器还没启动) 也会让 recv 失败, 和没有数据一样处理
+    SocketLength size = recv(handle, (char *)out, (int)capacity, 0);
+    return size < 0 ? -1 : (int)size;
+}
@@ -0,0 +1,184 @@
+#include "VersusScreen.h"
+#include "Audio.h"
+#include "Constants.h"
+#include "Game.h"
+#include "Profiler.h"
+
+VersusScreen::VersusScreen(void)
+    : lastQueuedDir{DIR_RIGHT, DIR_LEFT}, alpha(1.0f), lastStep{}, paused(false),
+      scoreTexts{{"P1: %i", 20}, {"P2: %i", 20}}, pausedLabel("PAUSED", 40, GRAY)
+{
+}
+
+void VersusScreen::Load(void)
+{
+    renderer.Load(GAME_AREA_WIDTH, GAME_AREA_HEIGHT, SQUARE_SIZE);
+    pausedLabel.Load();
+}
+
+void VersusScreen::Unload(void)
+{
+    pausedLabel.Unload();
+    renderer.Unload();
+}
+
+void VersusScreen::Enter(Game &)
+{
+    InitGame();
+}
+
+void VersusScreen::InitGame(void)
+{
+    paused = false;
+
+    uint64_t seed = (uint64_t)GetRandomValue(0, 0x7fffffff);
+    sim.Reset(ClassicBoard(), PLAYER_COUNT, seed);
+    for (int p = 0; p < PLAYER_COUNT; p++)
+    {
+        pendingTurns[p].Clear();
+        lastQueuedDir[p] = sim.Direction(p);
+    }
+
+    clock.Reset(MOVE_INTERVAL_MICROS);
+    alpha = 1.0f;
+    lastStep = {};
+    for (int p = 0; p < PLAYER_COUNT; p++)
+    {
+        lastStep.players[p].prevHead = sim.GetSnake(p).Head().position;
+    }
+}
+
+void VersusScreen::HandleInput(void)
+{
+    // 两个玩家共用一个键盘, 按下的顺序读取本帧所有按键, 再按键位分给各自的队列
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed())
+    {
+        switch (key)
+        {
+        case KEY_D:
+            QueueTurn(0, DIR_RIGHT);
+            break;
+        case KEY_A:
+            QueueTurn(0, DIR_LEFT);
+            break;
+        case KEY_W:
+            QueueTurn(0, DIR_UP);
+            break;
+        case KEY_S:
+            QueueTurn(0, DIR_DOWN);
+            break;
+        case KEY_RIGHT:
+            QueueTurn(1, DIR_RIGHT);
+            break;
+        case KEY_LEFT:
+            QueueTurn(1, DIR_LEFT);
+            break;
+        case KEY_UP:
+            QueueTurn(1, DIR_UP);
+            break;
+        case KEY_DOWN:
+            QueueTurn(1, DIR_DOWN);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void VersusScreen::QueueTurn(int player, SnakeDirection dir)
+{
+    if (dir == lastQueuedDir[player] || IsOpposite(dir, lastQueuedDir[player]))
+        return;
+
+    if (pendingTurns[player].Push(dir))
+        lastQueuedDir[player] = dir;
+}
+
+void VersusScreen::Update(Game &game, float frameTime)
+{
+    if (IsKeyPressed(KEY_ESCAPE))
+    {
+        game.ChangeScreen(SCREEN_MENU);
+        return;
+    }
+
+    if (IsKeyPressed(KEY_P))
+        paused = !paused;
+
+    if (paused)
+    {
+        // 暂停时按下的键不能在继续之后变成排队的转向: 清空 raylib 的按键队列
+        while (GetKeyPressed() != 0)
+        {
+        }
+        return;
+    }
+
+    HandleInput();
+
+    clock.Advance(frameTime);
+
+    int steps = 0;
+    while (steps < MAX_STEPS_PER_FRAME && clock.Consume())
+    {
+        StepGame();
+        steps++;
+
+        if (!sim.Running())
+        {
+            int winner = sim.Winner();
+            game.SetLastVersusResult(winner, winner >= 0 ? sim.Score(winner) : 0);
+            game.ChangeScreen(SCREEN_GAME_OVER);
+            return;
+        }
+    }
+
+    clock.DropBacklog();
+    alpha = clock.Alpha();
+}
+
+void VersusScreen::StepGame(void)
+{
+    SNAKE_PROFILE_SCOPE(PROFILE_STEP);
+
+    // 每个玩家每个 tick 最多消费一次转向
+    SnakeDirection inputs[PLAYER_COUNT];
+    for (int p = 0; p < PLAYER_COUNT; p++)
+    {
+        inputs[p] = sim.Direction(p);
+        pendingTurns[p].Pop(inputs[p]);
+    }
+
+    MultiStepResult result = sim.Step(inputs);
+    if (result.deaths > 0)
+    {
+        PlayGameSound(SOUND_GAME_OVER);
+    }
+    else
+    {
+        for (int p = 0; p < PLAYER_COUNT; p++)
+        {
+            if (result.players[p].ateFood)
+                PlayGameSound(SOUND_EAT);
+        }
+    }
+    lastStep = result;
+}
+
+void VersusScreen::Draw(const Game &)
+{
+    renderer.Draw(sim, lastStep, paused ? 1.0f : alpha);
+
+    // 分数按玩家颜色画在两个上角
+    for (int p = 0; p < PLAYER_COUNT; p++)
+    {
+        scoreTexts[p].Set(sim.Score(p));
+    }
+    scoreTexts[0].Draw(10, 10, ViewportRenderer::PlayerColor(0, true));
+    scoreTexts[1].Draw(SCREEN_WIDTH - scoreTexts[1].Width() - 10, 10, ViewportRenderer::PlayerColor(1, true));
+
+    if (paused)
+    {
+        pausedLabel.DrawCentered(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20);
+    }
+}
@@ -0,0 +1,98 @@
+#include "ViewportRenderer.h"
+#include <cmath>
+
+ViewportRenderer::ViewportRenderer(void)
+    : cells{}, viewWidth(0), viewHeight(0), textureWidth(0), textureHeight(0), cellSize(0)
+{
+}
+
+void ViewportRenderer::Load(int newViewWidth, int newViewHeight, int newCellSize)
+{
+    viewWidth = newViewWidth;
+    viewHeight = newViewHeight;
+    textureWidth = viewWidth + 1;
+    textureHeight = viewHeight + 1;
+    cellSize = newCellSize;
+
+    pixels.assign((size_t)textureWidth * textureHeight, BLANK);
+    Image image = GenImageColor(textureWidth, textureHeight, BLANK);
+    cells = LoadTextureFromImage(image);
+    UnloadImage(image);
+    SetTextureFilter(cells, TEXTURE_FILTER_POINT); // 放大时保持格子边缘锐利
+}
+
+void ViewportRenderer::Unload(void)
+{
+    UnloadTexture(cells);
+}
+
+float ViewportRenderer::CameraStart(float center, int boardSize, int viewSize) const
+{
+    if (boardSize <= viewSize)
+        return 0.0f;
+
+    float start = center - viewSize * 0.5f;
+    if (start < 0.0f)
+        return 0.0f;
+    if (start > (float)(boardSize - viewSize))
+        return (float)(boardSize - viewSize);
+    return start;
+}
+
+void ViewportRenderer::DrawCellLerp(Cell from, Cell to, float alpha, float left, float top, Color color) const
+{
+    Vector2 pixel = {
+        (from.x + (to.x - from.x) * alpha - left) * cellSize,
+        (from.y + (to.y - from.y) * alpha - top) * cellSize};
+    DrawRectangleV(pixel, {(float)cellSize, (float)cellSize}, color);
+}
+
+Color ViewportRenderer::PlayerColor(int player, bool head)
+{
+    static const Color BODY_COLORS[MAX_PLAYERS] = {GREEN, BLUE, ORANGE, PURPLE};
+    static const Color HEAD_COLORS[MAX_PLAYERS] = {DARKGREEN, DARKBLUE, BROWN, VIOLET};
+    return head ? HEAD_COLORS[player] : BODY_COLORS[player];
+}
+
+void ViewportRenderer::ClearVisible(Cell position, int originX, int originY)
+{
+    int x = position.x - originX;
+    int y = position.y - originY;
+    if (x >= 0 && x < textureWidth && y >= 0 && y < textureHeight)
+        pixels[(size_t)y * textureWidth + x] = BLANK;
+}
+
+void ViewportRenderer::PresentCells(float left, float top) const
+{
+    // 纹理的第一个格子是 (floor(left), floor(top)), 按小数部分向左上偏移
+    const float offsetX = -(left - std::floor(left)) * cellSize;
+    const float offsetY = -(top - std::floor(top)) * cellSize;
+    const float pixelWidth = (float)(textureWidth * cellSize);
+    const float pixelHeight = (float)(textureHeight * cellSize);
+
+    // 网格线
+    for (int i = 0; i <= textureWidth; i++)
+    {
+        int x = (int)(offsetX + i * cellSize);
+        DrawLine(x, 0, x, (int)pixelHeight, LIGHTGRAY);
+    }
+    for (int i = 0; i <= textureHeight; i++)
+    {
+        int y = (int)(offsetY + i * cellSize);
+        DrawLine(0, y, (int)pixelWidth, y, LIGHTGRAY);
+    }
+
+    DrawTexturePro(cells, {0, 0, (float)textureWidth, (float)textureHeight},
+                   {offsetX, offsetY, pixelWidth, pixelHeight}, {0, 0}, 0.0f, WHITE);
+}
+
+void ViewportRenderer::DrawMoving(float left, float top, const StepResult &step, Cell head, Cell tail, float alpha,
+                                  Color bodyColor, Color headColor) const
+{
+    // 身体画在当前 tick 的位置上, 蛇头和刚移走的蛇尾在两个 tick 之间插值
+    if (step.tailMoved)
+    {
+        DrawCellLerp(step.prevTail, tail, alpha, left, top, bodyColor);
+    }
+    DrawCellLerp(step.prevHead, head, alpha, left, top, headColor);
+}
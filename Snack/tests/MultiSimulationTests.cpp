@@ -0,0 +1,133 @@
+#include "MultiSimulation.h"
+#include "Test.h"
+#include <initializer_list>
+
+// ------------------------------------------------------------------------------------
+// 多条蛇的碰撞: 用 Restore 摆出固定的局面, 再推进一个 tick
+// ------------------------------------------------------------------------------------
+
+static void Place(MultiSimulation &sim, int player, std::initializer_list<Cell> body, SnakeDirection dir)
+{
+    sim.RestoreSnake(player, body.begin(), (int)body.size(), dir, 0, true);
+}
+
+static bool BoardEmptyExcept(const MultiSimulation &sim, int player)
+{
+    const DynamicBoard &board = sim.GetBoard();
+    for (int index = 0; index < board.CellCount(); index++)
+    {
+        int owner = sim.Owner(board.FromIndex(index));
+        if (owner >= 0 && owner != player)
+            return false;
+    }
+    return true;
+}
+
+SNAKE_TEST(MultiHeadOnSameCellKillsBoth)
+{
+    // 两个蛇头隔一格相对而行, 同时进入中间的格子
+    MultiSimulation sim;
+    sim.Restore(DynamicBoard(12, 5), 2, 10, SIM_RUNNING, -1);
+    Place(sim, 0, {{4, 2}, {3, 2}, {2, 2}}, DIR_RIGHT);
+    Place(sim, 1, {{6, 2}, {7, 2}, {8, 2}}, DIR_LEFT);
+    sim.PlaceFood({{0, 0}, true});
+
+    const SnakeDirection inputs[MAX_PLAYERS] = {DIR_RIGHT, DIR_LEFT};
+    MultiStepResult result = sim.Step(inputs);
+    CHECK(result.deaths == 2);
+    CHECK(result.players[0].died);
+    CHECK(result.players[1].died);
+    CHECK(!sim.Alive(0));
+    CHECK(!sim.Alive(1));
+    CHECK(sim.Status() == SIM_DEAD);
+    CHECK(sim.Winner() == -1);
+    CHECK(sim.Owner({5, 2}) == -1);
+    CHECK(BoardEmptyExcept(sim, -1));
+}
+
+SNAKE_TEST(MultiHeadsSwappingCellsKillsBoth)
+{
+    // 两个蛇头相邻, 互相冲进对方的蛇头
+    MultiSimulation sim;
+    sim.Restore(DynamicBoard(12, 5), 2, 10, SIM_RUNNING, -1);
+    Place(sim, 0, {{5, 2}, {4, 2}, {3, 2}}, DIR_RIGHT);
+    Place(sim, 1, {{6, 2}, {7, 2}, {8, 2}}, DIR_LEFT);
+    sim.PlaceFood({{0, 0}, true});
+
+    const SnakeDirection inputs[MAX_PLAYERS] = {DIR_RIGHT, DIR_LEFT};
+    MultiStepResult result = sim.Step(inputs);
+    CHECK(result.deaths == 2);
+    CHECK(!sim.Alive(0));
+    CHECK(!sim.Alive(1));
+    CHECK(sim.Winner() == -1);
+    CHECK(BoardEmptyExcept(sim, -1));
+}
+
+SNAKE_TEST(MultiHeadIntoBodyKillsMover)
+{
+    // 第 0 条蛇向下撞进第 1 条蛇的身体中段, 第 1 条蛇继续向左走
+    MultiSimulation sim;
+    sim.Restore(DynamicBoard(12, 6), 2, 10, SIM_RUNNING, -1);
+    Place(sim, 0, {{5, 1}, {4, 1}, {3, 1}}, DIR_RIGHT);
+    Place(sim, 1, {{4, 2}, {5, 2}, {6, 2}, {7, 2}}, DIR_LEFT);
+    sim.PlaceFood({{0, 5}, true});
+
+    const SnakeDirection inputs[MAX_PLAYERS] = {DIR_DOWN, DIR_LEFT};
+    MultiStepResult result = sim.Step(inputs);
+    CHECK(result.deaths == 1);
+    CHECK(result.players[0].died);
+    CHECK(!result.players[1].died);
+    CHECK(!sim.Alive(0));
+    CHECK(sim.Alive(1));
+    CHECK(sim.Status() == SIM_DEAD); // 只剩一条蛇, 这一局结束
+    CHECK(sim.Winner() == 1);
+
+    // 死掉的蛇从棋盘上移除, 活着的蛇照常推进
+    CHECK(BoardEmptyExcept(sim, 1));
+    CHECK(sim.GetSnake(1).Head().position == (Cell{3, 2}));
+    CHECK(sim.Owner({3, 2}) == 1);
+    CHECK(sim.Owner({5, 2}) == 1);
+    CHECK(sim.Owner({7, 2}) == -1);
+}
+
+SNAKE_TEST(MultiFollowingMovingTailSurvives)
+{
+    // 第 0 条蛇跟进第 1 条蛇正在移走的尾巴
+    MultiSimulation sim;
+    sim.Restore(DynamicBoard(12, 6), 2, 10, SIM_RUNNING, -1);
+    Place(sim, 0, {{3, 3}, {2, 3}, {1, 3}}, DIR_RIGHT);
+    Place(sim, 1, {{4, 1}, {4, 2}, {4, 3}}, DIR_UP);
+    sim.PlaceFood({{11, 5}, true});
+    CHECK(sim.IsDeadly({4, 2}));
+    CHECK(!sim.IsDeadly({4, 3}));
+
+    const SnakeDirection inputs[MAX_PLAYERS] = {DIR_RIGHT, DIR_UP};
+    MultiStepResult result = sim.Step(inputs);
+    CHECK(result.deaths == 0);
+    CHECK(result.players[0].tailMoved);
+    CHECK(result.players[1].tailMoved);
+    CHECK(sim.Running());
+    CHECK(sim.Alive(0));
+    CHECK(sim.Alive(1));
+    CHECK(sim.Owner({4, 3}) == 0);
+    CHECK(sim.Owner({4, 0}) == 1);
+    CHECK(sim.Owner({1, 3}) == -1);
+}
+
+SNAKE_TEST(MultiWallKillsOnlyThatSnake)
+{
+    MultiSimulation sim;
+    sim.Restore(DynamicBoard(10, 10), 3, 0, SIM_RUNNING, -1);
+    Place(sim, 0, {{9, 1}, {8, 1}, {7, 1}}, DIR_RIGHT);
+    Place(sim, 1, {{5, 5}, {6, 5}, {7, 5}}, DIR_LEFT);
+    Place(sim, 2, {{2, 8}, {3, 8}, {4, 8}}, DIR_LEFT);
+    sim.PlaceFood({{0, 0}, true});
+
+    const SnakeDirection inputs[MAX_PLAYERS] = {DIR_RIGHT, DIR_LEFT, DIR_LEFT};
+    MultiStepResult result = sim.Step(inputs);
+    CHECK(result.deaths == 1);
+    CHECK(!sim.Alive(0));
+    CHECK(sim.AliveCount() == 2);
+    CHECK(sim.Running()); // 还有两条蛇, 继续
+    CHECK(sim.Owner({9, 1}) == -1);
+}
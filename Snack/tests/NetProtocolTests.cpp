@@ -0,0 +1,255 @@
+#include "MultiSimulation.h"
+#include "NetProtocol.h"
+#include "Test.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// 联网协议: 关键帧 + delta 在副本上重建出和服务器一样的状态, 格式不对的数据报被拒绝
+// ------------------------------------------------------------------------------------
+
+static bool SameState(const ClassicMultiSimulation &a, const ClassicMultiSimulation &b)
+{
+    if (a.Ticks() != b.Ticks() || a.Status() != b.Status() || a.Winner() != b.Winner() ||
+        a.GetFood().active != b.GetFood().active || a.GetFood().position != b.GetFood().position)
+        return false;
+    for (int p = 0; p < a.PlayerCount(); p++)
+    {
+        if (a.Alive(p) != b.Alive(p) || a.Direction(p) != b.Direction(p) || a.Score(p) != b.Score(p))
+            return false;
+        if (!a.Alive(p))
+            continue;
+        const auto &snakeA = a.GetSnake(p);
+        const auto &snakeB = b.GetSnake(p);
+        if (snakeA.Size() != snakeB.Size())
+            return false;
+        for (size_t i = 0; i < snakeA.Size(); i++)
+        {
+            if (snakeA[i].position != snakeB[i].position)
+                return false;
+        }
+    }
+    return true;
+}
+
+// 不会立刻撞死的随机方向
+static SnakeDirection PickDirection(const ClassicMultiSimulation &sim, int player, Pcg32 &rng)
+{
+    const SnakeDirection current = sim.Direction(player);
+    const Cell head = sim.GetSnake(player).Head().position;
+    SnakeDirection choice = current;
+    if (rng.Bounded(4) == 0)
+        choice = (SnakeDirection)rng.Bounded(4);
+    for (int attempt = 0; attempt < 4; attempt++)
+    {
+        SnakeDirection dir = (SnakeDirection)((choice + attempt) % 4);
+        if (!IsOpposite(dir, current) && !sim.IsDeadly(MoveCell(head, dir)))
+            return dir;
+    }
+    return current;
+}
+
+SNAKE_TEST(NetKeyframeAndDeltasRoundTrip)
+{
+    const uint32_t room = 17;
+    const uint16_t round = 3;
+    ClassicMultiSimulation server;
+    server.Reset(ClassicBoard(), 2, 99, 4);
+    Pcg32 rng(5, 5);
+
+    // 服务器先走几步, 关键帧里的蛇已经转过弯
+    for (int tick = 0; tick < 40 && server.Running(); tick++)
+    {
+        SnakeDirection inputs[MAX_PLAYERS] = {PickDirection(server, 0, rng), PickDirection(server, 1, rng)};
+        server.Step(inputs);
+    }
+    REQUIRE(server.Running());
+
+    uint8_t buffer[NET_MAX_DATAGRAM];
+    size_t size = WriteKeyframe(buffer, sizeof(buffer), room, round, server);
+    REQUIRE(size > 0);
+    NetKeyframe keyframe;
+    REQUIRE(ReadKeyframe(buffer, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+    CHECK(keyframe.room == room);
+    CHECK(keyframe.round == round);
+    CHECK(keyframe.tick == server.Ticks());
+
+    ClassicNetReplica replica;
+    REQUIRE(replica.ApplyKeyframe(ClassicBoard(), keyframe));
+    CHECK(SameState(replica.GetSimulation(), server));
+
+    // 之后逐个 tick 发 delta, 每个数据报重复携带最近的几个
+    std::vector<NetDelta> history;
+    int applied = 0;
+    for (int tick = 0; tick < 2000 && server.Running(); tick++)
+    {
+        SnakeDirection inputs[MAX_PLAYERS] = {PickDirection(server, 0, rng), PickDirection(server, 1, rng)};
+        MultiStepResult step = server.Step(inputs);
+        SnakeDirection directions[MAX_PLAYERS] = {server.Direction(0), server.Direction(1)};
+        history.push_back(MakeDelta(server, step, directions));
+
+        const int count = (int)std::min(history.size(), (size_t)NET_DELTA_REDUNDANCY);
+        size = WriteDeltas(buffer, sizeof(buffer), room, round, 2, &history[history.size() - count], count);
+        REQUIRE(size > 0);
+
+        uint32_t readRoom = 0;
+        uint16_t readRound = 0;
+        int playerCount = 0;
+        int readCount = 0;
+        NetDelta deltas[NET_DELTA_REDUNDANCY];
+        REQUIRE(ReadDeltas(buffer, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, readRoom, readRound, playerCount, deltas,
+                           readCount));
+        CHECK(readRoom == room);
+        CHECK(readRound == round);
+        CHECK(playerCount == 2);
+        REQUIRE(readCount == count);
+
+        // 旧的 delta 已经应用过, 只有最后一个推进副本
+        for (int i = 0; i < readCount - 1; i++)
+        {
+            CHECK(replica.ApplyDelta(readRound, deltas[i]) == NET_STALE);
+        }
+        REQUIRE(replica.ApplyDelta(readRound, deltas[readCount - 1]) == NET_APPLIED);
+        applied++;
+        REQUIRE(SameState(replica.GetSimulation(), server));
+    }
+    CHECK(applied > 100);
+}
+
+SNAKE_TEST(NetReplicaDetectsGap)
+{
+    ClassicMultiSimulation server;
+    server.Reset(ClassicBoard(), 2, 1, 1);
+
+    uint8_t buffer[NET_MAX_DATAGRAM];
+    const size_t size = WriteKeyframe(buffer, sizeof(buffer), 1, 1, server);
+    NetKeyframe keyframe;
+    REQUIRE(ReadKeyframe(buffer, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+    ClassicNetReplica replica;
+    REQUIRE(replica.ApplyKeyframe(ClassicBoard(), keyframe));
+
+    SnakeDirection inputs[MAX_PLAYERS] = {DIR_RIGHT, DIR_LEFT};
+    server.Step(inputs);
+    MultiStepResult step = server.Step(inputs);
+    const NetDelta skipped = MakeDelta(server, step, inputs);
+    CHECK(replica.ApplyDelta(1, skipped) == NET_GAP);
+}
+
+SNAKE_TEST(NetRejectsTruncatedMessages)
+{
+    ClassicMultiSimulation server;
+    server.Reset(ClassicBoard(), 2, 3, 3);
+
+    uint8_t buffer[NET_MAX_DATAGRAM];
+    const size_t keyframeSize = WriteKeyframe(buffer, sizeof(buffer), 2, 2, server);
+    REQUIRE(keyframeSize > 0);
+    NetKeyframe keyframe;
+    for (size_t size = 0; size < keyframeSize; size++)
+    {
+        CHECK(!ReadKeyframe(buffer, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+    }
+    // 多出来的字节也不行
+    buffer[keyframeSize] = 0;
+    CHECK(!ReadKeyframe(buffer, keyframeSize + 1, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+    CHECK(ReadKeyframe(buffer, keyframeSize, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+
+    SnakeDirection inputs[MAX_PLAYERS] = {DIR_RIGHT, DIR_LEFT};
+    MultiStepResult step = server.Step(inputs);
+    NetDelta delta = MakeDelta(server, step, inputs);
+    delta.flags |= NET_FOOD_EVENT;
+    delta.food = {5, 5};
+    const size_t deltaSize = WriteDeltas(buffer, sizeof(buffer), 2, 2, 2, &delta, 1);
+    REQUIRE(deltaSize > 0);
+
+    uint32_t room = 0;
+    uint16_t round = 0;
+    int playerCount = 0;
+    int count = 0;
+    NetDelta deltas[NET_DELTA_REDUNDANCY];
+    for (size_t size = 0; size < deltaSize; size++)
+    {
+        CHECK(!ReadDeltas(buffer, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, room, round, playerCount, deltas, count));
+    }
+    CHECK(ReadDeltas(buffer, deltaSize, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, room, round, playerCount, deltas, count));
+    CHECK(count == 1);
+    CHECK(deltas[0].food == (Cell{5, 5}));
+}
+
+SNAKE_TEST(NetRejectsFoodOutsideBoard)
+{
+    NetDelta delta = {};
+    delta.tick = 1;
+    delta.flags = NET_FOOD_EVENT;
+    delta.players[0] = DIR_RIGHT | NET_TAIL_MOVED | NET_ATE_FOOD;
+
+    uint32_t room = 0;
+    uint16_t round = 0;
+    int playerCount = 0;
+    int count = 0;
+    NetDelta deltas[NET_DELTA_REDUNDANCY];
+    uint8_t buffer[NET_MAX_DATAGRAM];
+
+    const Cell outside[] = {{GAME_AREA_WIDTH, 0}, {0, GAME_AREA_HEIGHT}, {-1, 3}, {3, -1}};
+    for (Cell food : outside)
+    {
+        delta.food = food;
+        const size_t size = WriteDeltas(buffer, sizeof(buffer), 1, 1, 1, &delta, 1);
+        REQUIRE(size > 0);
+        CHECK(!ReadDeltas(buffer, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, room, round, playerCount, deltas, count));
+    }
+
+    delta.food = {GAME_AREA_WIDTH - 1, GAME_AREA_HEIGHT - 1};
+    const size_t size = WriteDeltas(buffer, sizeof(buffer), 1, 1, 1, &delta, 1);
+    CHECK(ReadDeltas(buffer, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, room, round, playerCount, deltas, count));
+}
+
+SNAKE_TEST(NetKeyframeRejectsOverlappingBodies)
+{
+    // 两条长度为 3 的蛇: 每条 12 字节 + 1 字节的方向, 第 0 条从偏移 19 开始, 第 1 条从 32 开始
+    ClassicMultiSimulation server;
+    server.Reset(ClassicBoard(), 2, 8, 8);
+    REQUIRE(server.GetSnake(0).Size() == 3);
+    REQUIRE(server.GetSnake(1).Size() == 3);
+
+    uint8_t buffer[NET_MAX_DATAGRAM];
+    const size_t size = WriteKeyframe(buffer, sizeof(buffer), 1, 1, server);
+    REQUIRE(size == 19 + 2 * 13);
+    NetKeyframe keyframe;
+    REQUIRE(ReadKeyframe(buffer, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+
+    // 第 0 条蛇的第二步掉头, 回到蛇头的格子
+    uint8_t crossing[NET_MAX_DATAGRAM];
+    memcpy(crossing, buffer, size);
+    const uint8_t first = crossing[31] & NET_DIRECTION_MASK;
+    crossing[31] = (uint8_t)(first | ((first ^ 1) << 2));
+    CHECK(!ReadKeyframe(crossing, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+
+    // 第 1 条蛇的蛇头放在第 0 条蛇的蛇头上
+    const Cell head = server.GetSnake(0).Head().position;
+    memcpy(crossing, buffer, size);
+    crossing[40] = (uint8_t)(head.x & 0xff);
+    crossing[41] = (uint8_t)(head.x >> 8);
+    crossing[42] = (uint8_t)(head.y & 0xff);
+    crossing[43] = (uint8_t)(head.y >> 8);
+    CHECK(!ReadKeyframe(crossing, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+
+    // 蛇身走出棋盘
+    memcpy(crossing, buffer, size);
+    crossing[40] = (uint8_t)GAME_AREA_WIDTH;
+    crossing[41] = 0;
+    CHECK(!ReadKeyframe(crossing, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+
+    // 赢家只能是 -1 (没有) 或者某个玩家, 在偏移 12
+    memcpy(crossing, buffer, size);
+    crossing[12] = (uint8_t)(int8_t)-5;
+    CHECK(!ReadKeyframe(crossing, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+    crossing[12] = 2;
+    CHECK(!ReadKeyframe(crossing, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+    crossing[12] = 1;
+    REQUIRE(ReadKeyframe(crossing, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+    CHECK(keyframe.winner == 1);
+    crossing[12] = (uint8_t)(int8_t)-1;
+    REQUIRE(ReadKeyframe(crossing, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe));
+    CHECK(keyframe.winner == -1);
+}
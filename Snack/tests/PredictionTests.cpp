@@ -0,0 +1,100 @@
+#include "MultiSimulation.h"
+#include "Prediction.h"
+#include "Test.h"
+
+// ------------------------------------------------------------------------------------
+// 客户端预测: 对手转向时回滚并用记录的本地输入重新推进
+// ------------------------------------------------------------------------------------
+
+SNAKE_TEST(PredictionRollsBackOnOpponentTurn)
+{
+    ClassicMultiSimulation server;
+    server.Reset(ClassicBoard(), 2, 42, 6);
+    // 食物放到远处, 几个 tick 里谁都吃不到 (食物只由服务器决定)
+    server.PlaceFood({{0, 0}, true});
+
+    ClassicPredictor predictor;
+    predictor.Reset(server, 0);
+
+    // 本地玩家 0 一直向右, 预测时对手沿用向左
+    for (int tick = 0; tick < 5; tick++)
+    {
+        REQUIRE(predictor.Advance(DIR_RIGHT));
+    }
+    CHECK(predictor.Lead() == 5);
+
+    // 服务器上对手在第 1 个 tick 就转向上
+    const SnakeDirection turn[MAX_PLAYERS] = {DIR_RIGHT, DIR_UP};
+    server.Step(turn);
+    CHECK(predictor.Reconcile(server));
+    CHECK(predictor.Rollbacks() == 1);
+    CHECK(predictor.ResimulatedTicks() == 4);
+    CHECK(predictor.LocalMispredictions() == 0);
+    CHECK(predictor.Lead() == 4);
+
+    // 回滚之后的预测等于从权威状态出发, 用同样的输入走 4 个 tick
+    ClassicMultiSimulation expected;
+    CopyState(expected, server);
+    for (int tick = 0; tick < 4; tick++)
+    {
+        expected.Step(turn);
+    }
+    const ClassicMultiSimulation &predicted = predictor.GetSimulation();
+    CHECK(predicted.Ticks() == expected.Ticks());
+    for (int p = 0; p < 2; p++)
+    {
+        CHECK(predicted.Direction(p) == expected.Direction(p));
+        CHECK(predicted.GetSnake(p).Head().position == expected.GetSnake(p).Head().position);
+        CHECK(predicted.GetSnake(p).Tail().position == expected.GetSnake(p).Tail().position);
+    }
+
+    // 服务器之后的 tick 和新的预测一致, 不再回滚
+    for (int tick = 0; tick < 4; tick++)
+    {
+        server.Step(turn);
+        CHECK(!predictor.Reconcile(server));
+    }
+    CHECK(predictor.Rollbacks() == 1);
+    CHECK(predictor.Lead() == 0);
+}
+
+SNAKE_TEST(PredictionCountsLateLocalInput)
+{
+    ClassicMultiSimulation server;
+    server.Reset(ClassicBoard(), 2, 42, 6);
+    server.PlaceFood({{0, 0}, true});
+
+    ClassicPredictor predictor;
+    predictor.Reset(server, 0);
+    REQUIRE(predictor.Advance(DIR_DOWN));
+    REQUIRE(predictor.Advance(DIR_DOWN));
+
+    // 本地的转向晚到了一个 tick: 服务器第 1 个 tick 仍然向右
+    const SnakeDirection late[MAX_PLAYERS] = {DIR_RIGHT, DIR_LEFT};
+    server.Step(late);
+    CHECK(predictor.Reconcile(server));
+    CHECK(predictor.LocalMispredictions() == 1);
+    CHECK(predictor.ResimulatedTicks() == 1);
+    CHECK(predictor.GetSimulation().Direction(0) == DIR_DOWN);
+}
+
+SNAKE_TEST(PredictionStopsAtHistoryLimit)
+{
+    ClassicMultiSimulation server;
+    server.Reset(ClassicBoard(), 1, 1, 2);
+    server.PlaceFood({{0, 0}, true});
+
+    ClassicPredictor predictor;
+    predictor.Reset(server, 0);
+    // 锯齿形向右走 (右, 上, 右, 下), 不会撞墙也不会碰到自己
+    const SnakeDirection pattern[4] = {DIR_RIGHT, DIR_UP, DIR_RIGHT, DIR_DOWN};
+    int advanced = 0;
+    for (int tick = 0; tick < ClassicPredictor::HISTORY + 5; tick++)
+    {
+        if (predictor.Advance(pattern[tick % 4]))
+            advanced++;
+    }
+    CHECK(predictor.GetSimulation().Running());
+    CHECK(advanced == ClassicPredictor::HISTORY - 1);
+    CHECK(predictor.Lead() == ClassicPredictor::HISTORY - 1);
+}
@@ -0,0 +1,51 @@
+#include "Profiler.h"
+#include "Test.h"
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------
+// Profiler 的直方图: 每个值都落在自己的桶里, 桶的边界首尾相接, 最大的值不会越界
+// ------------------------------------------------------------------------------------
+
+SNAKE_TEST(ProfileBucketBoundsAreContiguous)
+{
+    double previousHigh = 0.0;
+    for (int bucket = 0; bucket < PROFILE_BUCKET_COUNT; bucket++)
+    {
+        double low, high;
+        ProfileBucketBounds(bucket, low, high);
+        CHECK(low == previousHigh);
+        CHECK(high > low);
+        CHECK(ProfileBucketOf((uint64_t)low) == bucket);
+        CHECK(ProfileBucketOf((uint64_t)high - 1) == bucket);
+        previousHigh = high;
+    }
+    CHECK(previousHigh == (double)(1ull << PROFILE_MAX_EXPONENT));
+}
+
+SNAKE_TEST(ProfileBucketClampsHugeSamples)
+{
+    const int last = PROFILE_BUCKET_COUNT - 1;
+    CHECK(ProfileBucketOf((1ull << PROFILE_MAX_EXPONENT) - 1) == last);
+    CHECK(ProfileBucketOf(1ull << PROFILE_MAX_EXPONENT) == last);
+    CHECK(ProfileBucketOf((1ull << PROFILE_MAX_EXPONENT) * 15 / 8) == last);
+    CHECK(ProfileBucketOf(1ull << 63) == last);
+    CHECK(ProfileBucketOf(UINT64_MAX) == last);
+    for (int bit = 0; bit < 64; bit++)
+    {
+        const int bucket = ProfileBucketOf((1ull << bit) | ((1ull << bit) - 1));
+        CHECK(bucket >= 0 && bucket < PROFILE_BUCKET_COUNT);
+    }
+}
+
+#ifdef SNAKE_ENABLE_PROFILER
+SNAKE_TEST(ProfileRecordKeepsHugeSamples)
+{
+    ResetProfile();
+    ProfileRecord(PROFILE_STEP, 100);
+    ProfileRecord(PROFILE_STEP, UINT64_MAX / 2);
+    const ProfileSummary summary = GetProfileSummary(PROFILE_STEP);
+    CHECK(summary.count == 2);
+    CHECK(summary.maxUs == (double)(UINT64_MAX / 2) / 1000.0);
+    ResetProfile();
+}
+#endif
@@ -0,0 +1,221 @@
+#include "Autopilot.h"
+#include "Replay.h"
+#include "Simulation.h"
+#include "Test.h"
+#include <cstdio>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// 录像: 录制 -> 保存 -> 读取 -> 回放得到同一局, Seek 经过检查点得到同样的状态
+// ------------------------------------------------------------------------------------
+
+static const char *REPLAY_FILE = "snake_tests_replay.snkr";
+static const char *BROKEN_FILE = "snake_tests_broken.snkr";
+
+// 用自动驾驶录一局, 每个 tick 之后的蛇头存进 heads (heads[t] 是第 t 个 tick 之后的蛇头)
+static Replay RecordGame(const DynamicBoard &board, uint64_t seed, uint64_t maxTicks, std::vector<Cell> &heads)
+{
+    Simulation sim;
+    Autopilot pilot;
+    ReplayRecorder recorder;
+    sim.Reset(board, seed, 9);
+    pilot.Reset(board, AUTOPILOT_BFS);
+    recorder.Begin(board.Width(), board.Height(), seed, 9, sim.Direction());
+
+    heads.assign(1, sim.GetSnake().Head().position);
+    while (sim.Running() && sim.Ticks() < maxTicks)
+    {
+        sim.Step(pilot.Decide(sim));
+        recorder.RecordTick(sim.Ticks(), sim.Direction());
+        heads.push_back(sim.GetSnake().Head().position);
+    }
+    recorder.Finish(sim.Ticks(), sim.Score(), sim.Status());
+    return recorder.GetReplay();
+}
+
+static std::vector<uint8_t> ReadFileBytes(const char *fileName)
+{
+    std::vector<uint8_t> bytes;
+    FILE *file = fopen(fileName, "rb");
+    if (file == nullptr)
+        return bytes;
+    int c;
+    while ((c = fgetc(file)) != EOF)
+    {
+        bytes.push_back((uint8_t)c);
+    }
+    fclose(file);
+    return bytes;
+}
+
+static bool WriteFileBytes(const char *fileName, const std::vector<uint8_t> &bytes, size_t count)
+{
+    FILE *file = fopen(fileName, "wb");
+    if (file == nullptr)
+        return false;
+    bool ok = fwrite(bytes.data(), 1, count, file) == count;
+    return fclose(file) == 0 && ok;
+}
+
+SNAKE_TEST(ReplaySaveLoadRoundTrip)
+{
+    const DynamicBoard board(40, 30);
+    std::vector<Cell> heads;
+    const Replay recorded = RecordGame(board, 2024, 5000, heads);
+    REQUIRE(recorded.tickCount > 2 * ReplayPlayer::CHECKPOINT_INTERVAL);
+    REQUIRE(recorded.eventCount > 0);
+
+    REQUIRE(SaveReplay(REPLAY_FILE, recorded));
+    Replay loaded;
+    const bool ok = LoadReplay(REPLAY_FILE, loaded);
+    remove(REPLAY_FILE);
+    REQUIRE(ok);
+
+    CHECK(loaded.width == recorded.width);
+    CHECK(loaded.height == recorded.height);
+    CHECK(loaded.seed == recorded.seed);
+    CHECK(loaded.stream == recorded.stream);
+    CHECK(loaded.tickCount == recorded.tickCount);
+    CHECK(loaded.score == recorded.score);
+    CHECK(loaded.status == recorded.status);
+    CHECK(loaded.eventCount == recorded.eventCount);
+    CHECK(loaded.events == recorded.events);
+
+    // 回放每个 tick 的蛇头都和录制时一样
+    ReplayPlayer player;
+    REQUIRE(player.Open(loaded, board));
+    CHECK(!player.Open(loaded, DynamicBoard(10, 10)));
+    REQUIRE(player.Open(loaded, board));
+    while (!player.AtEnd())
+    {
+        player.Step();
+        const uint64_t tick = player.GetSimulation().Ticks();
+        REQUIRE(tick < heads.size());
+        CHECK(player.GetSimulation().GetSnake().Head().position == heads[tick]);
+    }
+    CHECK(player.Matches());
+}
+
+SNAKE_TEST(ReplaySeekUsesCheckpoints)
+{
+    const DynamicBoard board(40, 30);
+    std::vector<Cell> heads;
+    const Replay replay = RecordGame(board, 77, 5000, heads);
+    REQUIRE(replay.tickCount > 3000);
+
+    // 参照: 从头一步一步走到第 3000 个 tick
+    ReplayPlayer reference;
+    REQUIRE(reference.Open(replay, board));
+    while (reference.GetSimulation().Ticks() < 3000)
+    {
+        reference.Step();
+    }
+
+    // 先播放到结尾 (保存所有检查点), 再往回跳到检查点之间的位置
+    ReplayPlayer player;
+    REQUIRE(player.Open(replay, board));
+    player.Seek(replay.tickCount);
+    CHECK(player.AtEnd());
+    CHECK(player.Matches());
+
+    player.Seek(3000);
+    const Simulation &seeked = player.GetSimulation();
+    const Simulation &expected = reference.GetSimulation();
+    REQUIRE(seeked.Ticks() == 3000);
+    CHECK(seeked.Score() == expected.Score());
+    CHECK(seeked.Direction() == expected.Direction());
+    CHECK(seeked.GetFood().position == expected.GetFood().position);
+    REQUIRE(seeked.GetSnake().Size() == expected.GetSnake().Size());
+    for (size_t i = 0; i < seeked.GetSnake().Size(); i++)
+    {
+        CHECK(seeked.GetSnake()[i].position == expected.GetSnake()[i].position);
+    }
+
+    // 往回跳到同一个检查点区间里更早的位置, 再往前跳
+    player.Seek(2100);
+    CHECK(player.GetSimulation().Ticks() == 2100);
+    CHECK(player.GetSimulation().GetSnake().Head().position == heads[2100]);
+    player.Seek(10);
+    CHECK(player.GetSimulation().GetSnake().Head().position == heads[10]);
+    player.Seek(replay.tickCount);
+    CHECK(player.Matches());
+}
+
+SNAKE_TEST(ReplayCheckpointsStayWithinBudget)
+{
+    const DynamicBoard board(40, 30);
+    std::vector<Cell> heads;
+    const Replay replay = RecordGame(board, 31, 12000, heads);
+    REQUIRE(replay.tickCount > 10 * ReplayPlayer::CHECKPOINT_INTERVAL);
+
+    // 预算只够 3 个检查点: 播放过程中要反复隔一个丢一个
+    ReplayPlayer player;
+    REQUIRE(player.Open(replay, board, 3 * sizeof(Simulation) + 3 * 40 * 30 * 12 + 512));
+    player.Seek(replay.tickCount);
+    CHECK(player.Matches());
+    CHECK(player.CheckpointCount() <= 3);
+    CHECK(player.CheckpointCount() >= 2);
+    CHECK(player.CheckpointInterval() >= 4 * ReplayPlayer::CHECKPOINT_INTERVAL);
+    CHECK(player.CheckpointInterval() * player.CheckpointCount() > replay.tickCount / 2);
+
+    // 留下的检查点仍然给出正确的状态, 往前往后跳都一样
+    const uint64_t targets[] = {replay.tickCount - 1, 5, 7777, 1, 4096, replay.tickCount / 2, 0};
+    for (uint64_t target : targets)
+    {
+        player.Seek(target);
+        REQUIRE(player.GetSimulation().Ticks() == target);
+        CHECK(player.GetSimulation().GetSnake().Head().position == heads[target]);
+    }
+
+    // 默认预算下普通的棋盘不会加倍
+    REQUIRE(player.Open(replay, board));
+    player.Seek(replay.tickCount);
+    CHECK(player.CheckpointInterval() == ReplayPlayer::CHECKPOINT_INTERVAL);
+    CHECK(player.CheckpointCount() == replay.tickCount / ReplayPlayer::CHECKPOINT_INTERVAL + 1);
+}
+
+SNAKE_TEST(ReplayLoadRejectsBrokenFiles)
+{
+    const DynamicBoard board(12, 10);
+    std::vector<Cell> heads;
+    const Replay replay = RecordGame(board, 5, 2000, heads);
+    REQUIRE(SaveReplay(REPLAY_FILE, replay));
+    std::vector<uint8_t> bytes = ReadFileBytes(REPLAY_FILE);
+    remove(REPLAY_FILE);
+    REQUIRE(bytes.size() > 46);
+
+    Replay loaded;
+    // 转向事件少了一个字节
+    REQUIRE(WriteFileBytes(BROKEN_FILE, bytes, bytes.size() - 1));
+    CHECK(!LoadReplay(BROKEN_FILE, loaded));
+
+    // 文件头写完就断了
+    REQUIRE(WriteFileBytes(BROKEN_FILE, bytes, 20));
+    CHECK(!LoadReplay(BROKEN_FILE, loaded));
+
+    // 宽度超出 16 位坐标, 或者只比 MAX_BOARD_SIZE 大一格 (回放时按棋盘大小分配内存)
+    std::vector<uint8_t> wide = bytes;
+    wide[5] = 0xff;
+    wide[6] = 0xff;
+    REQUIRE(WriteFileBytes(BROKEN_FILE, wide, wide.size()));
+    CHECK(!LoadReplay(BROKEN_FILE, loaded));
+    wide[5] = (uint8_t)((MAX_BOARD_SIZE + 1) & 0xff);
+    wide[6] = (uint8_t)((MAX_BOARD_SIZE + 1) >> 8);
+    REQUIRE(WriteFileBytes(BROKEN_FILE, wide, wide.size()));
+    CHECK(!LoadReplay(BROKEN_FILE, loaded));
+
+    // 声称的事件字节数比文件大得多 (不能先按它分配内存)
+    std::vector<uint8_t> huge = bytes;
+    huge[42] = 0xff;
+    huge[43] = 0xff;
+    huge[44] = 0xff;
+    huge[45] = 0x7f;
+    REQUIRE(WriteFileBytes(BROKEN_FILE, huge, huge.size()));
+    CHECK(!LoadReplay(BROKEN_FILE, loaded));
+
+    // 原样写回去仍然可以读
+    REQUIRE(WriteFileBytes(BROKEN_FILE, bytes, bytes.size()));
+    CHECK(LoadReplay(BROKEN_FILE, loaded));
+    CHECK(loaded.events == replay.events);
+    remove(BROKEN_FILE);
+}
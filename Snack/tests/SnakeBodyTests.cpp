@@ -0,0 +1,111 @@
+#include "Autopilot.h"
+#include "Food.h"
+#include "Simulation.h"
+#include "Snacke.h"
+#include "Test.h"
+
+// ------------------------------------------------------------------------------------
+// 环形缓冲区, 占用位图和空闲格子索引三者必须一直一致
+// ------------------------------------------------------------------------------------
+
+template <class Board>
+static bool BodyMatchesOccupancy(const BasicSnake<Board> &snake, const Board &board)
+{
+    int occupied = 0;
+    for (int index = 0; index < board.CellCount(); index++)
+    {
+        if (snake.IsOccupied(board.FromIndex(index)))
+            occupied++;
+    }
+    if ((size_t)occupied != snake.Size())
+        return false;
+    for (size_t i = 0; i < snake.Size(); i++)
+    {
+        if (!snake.IsOccupied(snake[i].position))
+            return false;
+    }
+    return true;
+}
+
+SNAKE_TEST(SnakeRingBufferWrapsAround)
+{
+    const DynamicBoard board(7, 5);
+    Snake snake;
+    FoodSpawner spawner;
+    snake.Reset(board);
+    spawner.Reset(board);
+    REQUIRE(snake.Capacity() == (size_t)board.CellCount());
+
+    // 沿着第 0 行和第 1 行组成的 14 格回路走, 最长 6 节; 蛇头的下标会绕过缓冲区的起点很多次
+    Pcg32 rng(7, 1);
+    int step = 0;
+    for (int round = 0; round < 200; round++)
+    {
+        int index = step % 14;
+        Cell next = (index < 7) ? Cell{(int16_t)index, 0} : Cell{(int16_t)(13 - index), 1};
+        step++;
+
+        bool grow = snake.Size() < 6 && round % 3 == 0;
+        if (!grow && !snake.Empty())
+        {
+            spawner.Release(snake.Tail().position);
+            snake.PopTail();
+        }
+        snake.PushHead({next});
+        spawner.Occupy(next);
+
+        CHECK(snake.Head().position == next);
+        CHECK(BodyMatchesOccupancy(snake, board));
+        CHECK(spawner.FreeCount() == board.CellCount() - (int)snake.Size());
+
+        Food food = {};
+        REQUIRE(spawner.Spawn(food, rng));
+        CHECK(food.active);
+        CHECK(!snake.IsOccupied(food.position));
+    }
+}
+
+SNAKE_TEST(SpawnerReportsFullBoard)
+{
+    const DynamicBoard board(3, 2);
+    FoodSpawner spawner;
+    spawner.Reset(board);
+    for (int index = 0; index < board.CellCount(); index++)
+    {
+        spawner.Occupy(board.FromIndex(index));
+    }
+    CHECK(spawner.FreeCount() == 0);
+
+    Pcg32 rng(1);
+    Food food = {};
+    CHECK(!spawner.Spawn(food, rng));
+
+    spawner.Release({2, 1});
+    REQUIRE(spawner.Spawn(food, rng));
+    CHECK(food.position == (Cell{2, 1}));
+}
+
+SNAKE_TEST(SimulationKeepsBodyAndFoodConsistent)
+{
+    ClassicSimulation sim;
+    ClassicAutopilot pilot;
+    const ClassicBoard board;
+    sim.Reset(board, 12345, 3);
+    pilot.Reset(board, AUTOPILOT_BFS);
+
+    for (int tick = 0; tick < 20000 && sim.Running(); tick++)
+    {
+        const size_t before = sim.GetSnake().Size();
+        StepResult result = sim.Step(pilot.Decide(sim));
+        const auto &snake = sim.GetSnake();
+
+        CHECK(snake.Size() == before + (result.ateFood ? 1 : 0));
+        CHECK(result.tailMoved == !result.ateFood);
+        if (sim.GetFood().active)
+            CHECK(!snake.IsOccupied(sim.GetFood().position));
+        if (tick % 97 == 0)
+            CHECK(BodyMatchesOccupancy(snake, board));
+    }
+    CHECK(sim.Status() != SIM_DEAD);
+    CHECK(BodyMatchesOccupancy(sim.GetSnake(), board));
+}
@@ -0,0 +1,101 @@
+#include "StatsStore.h"
+#include "Test.h"
+#include <cstdio>
+#include <filesystem>
+
+// ------------------------------------------------------------------------------------
+// 战绩日志: 重新打开时重建索引, 最后一条写了一半的记录被丢弃并被下一条覆盖
+// ------------------------------------------------------------------------------------
+
+static const char *STATS_FILE = "snake_tests_stats.bin";
+static const uintmax_t STATS_HEADER = 8;
+static const uintmax_t STATS_RECORD = 40;
+
+static GameRecord MakeGame(int64_t timestamp, int score, uint64_t ticks, bool autopilot = false)
+{
+    GameRecord record = {};
+    record.timestamp = timestamp;
+    record.ticks = ticks;
+    record.score = score;
+    record.length = (uint32_t)(score + 3);
+    record.durationMillis = (uint32_t)(ticks * 100);
+    record.width = 40;
+    record.height = 30;
+    record.status = SIM_DEAD;
+    record.autopilot = autopilot;
+    return record;
+}
+
+SNAKE_TEST(StatsStoreReopenDropsTornRecord)
+{
+    remove(STATS_FILE);
+    {
+        StatsStore stats;
+        stats.Open(STATS_FILE);
+        CHECK(stats.Record(MakeGame(1, 10, 500)) == 0);
+        CHECK(stats.Record(MakeGame(2, 30, 900)) == 0);
+        CHECK(stats.Record(MakeGame(3, 20, 700)) == 1);
+        stats.Close();
+        CHECK(stats.DroppedRecords() == 0);
+    }
+    REQUIRE(std::filesystem::file_size(STATS_FILE) == STATS_HEADER + 3 * STATS_RECORD);
+
+    // 模拟写最后一条记录时程序退出: 只留下 13 个字节
+    std::filesystem::resize_file(STATS_FILE, STATS_HEADER + 2 * STATS_RECORD + 13);
+    {
+        StatsStore stats;
+        stats.Open(STATS_FILE);
+        CHECK(stats.GamesPlayed() == 2);
+        CHECK(stats.TotalTicks() == 1400);
+        REQUIRE(stats.LeaderboardCount() == 2);
+        CHECK(stats.Leaderboard(0).score == 30);
+        CHECK(stats.Leaderboard(1).score == 10);
+
+        // 新记录写在半条记录的位置上
+        CHECK(stats.Record(MakeGame(4, 25, 800)) == 1);
+        stats.Close();
+    }
+    CHECK(std::filesystem::file_size(STATS_FILE) == STATS_HEADER + 3 * STATS_RECORD);
+
+    {
+        StatsStore stats;
+        stats.Open(STATS_FILE);
+        CHECK(stats.GamesPlayed() == 3);
+        CHECK(stats.TotalTicks() == 2200);
+        REQUIRE(stats.LeaderboardCount() == 3);
+        CHECK(stats.Leaderboard(0).score == 30);
+        CHECK(stats.Leaderboard(1).score == 25);
+        CHECK(stats.Leaderboard(1).timestamp == 4);
+        CHECK(stats.Leaderboard(2).score == 10);
+        stats.Close();
+    }
+    remove(STATS_FILE);
+}
+
+SNAKE_TEST(StatsStoreSkipsCorruptRecord)
+{
+    remove(STATS_FILE);
+    {
+        StatsStore stats;
+        stats.Open(STATS_FILE);
+        stats.Record(MakeGame(1, 10, 500));
+        stats.Record(MakeGame(2, 30, 900));
+        stats.Record(MakeGame(3, 20, 700, true)); // 自动驾驶的局只计入统计
+        stats.Close();
+    }
+
+    // 改掉第一条记录的分数, 校验和对不上
+    FILE *file = fopen(STATS_FILE, "r+b");
+    REQUIRE(file != nullptr);
+    fseek(file, (long)(STATS_HEADER + 16), SEEK_SET);
+    fputc(0x7f, file);
+    fclose(file);
+
+    StatsStore stats;
+    stats.Open(STATS_FILE);
+    CHECK(stats.GamesPlayed() == 2);
+    REQUIRE(stats.LeaderboardCount() == 1);
+    CHECK(stats.Leaderboard(0).score == 30);
+    stats.Close();
+    remove(STATS_FILE);
+}
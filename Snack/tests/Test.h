@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// 最小的测试框架, 不依赖第三方库
+// - SNAKE_TEST(Name) 定义并注册一个用例, TestMain 按注册顺序运行 (可以用子串过滤)
+// - CHECK 失败时记录文件和行号, 继续执行这个用例; REQUIRE 失败时结束这个用例
+// ------------------------------------------------------------------------------------
+
+struct TestCase
+{
+    const char *name;
+    void (*run)(void);
+};
+
+inline std::vector<TestCase> &TestRegistry(void)
+{
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+inline int &TestFailures(void)
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline void ReportFailure(const char *file, int line, const char *expression)
+{
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    TestFailures()++;
+}
+
+struct TestRegistrar
+{
+    TestRegistrar(const char *name, void (*run)(void)) { TestRegistry().push_back({name, run}); }
+};
+
+#define SNAKE_TEST(name)                                                                                               \
+    static void name(void);                                                                                            \
+    static TestRegistrar name##Registrar(#name, name);                                                                 \
+    static void name(void)
+
+#define CHECK(expression)                                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expression))                                                                                             \
+            ReportFailure(__FILE__, __LINE__, #expression);                                                            \
+    } while (0)
+
+#define REQUIRE(expression)                                                                                            \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expression))                                                                                             \
+        {                                                                                                              \
+            ReportFailure(__FILE__, __LINE__, #expression);                                                            \
+            return;                                                                                                    \
+        }                                                                                                              \
+    } while (0)
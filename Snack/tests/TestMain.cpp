@@ -0,0 +1,37 @@
+// ------------------------------------------------------------------------------------
+// 单元测试: 不需要窗口和网络, ctest 直接运行
+//
+// 用法:
+//   snake_tests [FILTER]   只运行名字里包含 FILTER 的用例
+// ------------------------------------------------------------------------------------
+#include "Test.h"
+#include <cstring>
+
+int main(int argc, char **argv)
+{
+    const char *filter = (argc > 1) ? argv[1] : nullptr;
+
+    int run = 0;
+    int failed = 0;
+    for (const TestCase &test : TestRegistry())
+    {
+        if (filter != nullptr && strstr(test.name, filter) == nullptr)
+            continue;
+
+        const int before = TestFailures();
+        test.run();
+        run++;
+        if (TestFailures() != before)
+        {
+            failed++;
+            printf("FAILED  %s\n", test.name);
+        }
+        else
+        {
+            printf("ok      %s\n", test.name);
+        }
+    }
+
+    printf("%d tests, %d failed\n", run, failed);
+    return (failed == 0 && run > 0) ? 0 : 1;
+}
@@ -0,0 +1,544 @@
+// ------------------------------------------------------------------------------------
+// 无窗口模拟器: 不需要 InitWindow / GPU, 以最快速度跑完多局游戏并报告 tick/s
+//
+// 用法:
+//   Headless [--games N] [--width W] [--height H] [--seed S] [--max-ticks T]
+//            [--policy greedy|random|auto|cycle] [--script FILE] [--batch B] [--threads T]
+//            [--record FILE] [--profile FILE.csv|FILE.json] [--players P] [--expect-survival 1]
+//   Headless --replay FILE [--seek T]
+//
+// --script 读取一个方向脚本, 每个字符对应一个 tick: R L U D 转向, 其它字符保持方向;
+// 脚本用完后循环使用
+//
+// --batch 用 BatchEnv 同时推进 B 局 (贪心策略), 结束的局原地重开, 直到累计结束 N 局
+// 或者推进了 max-ticks 步; --threads 指定线程数 (0 = 全部硬件线程)
+//
+// --record 把第一局保存成录像; --replay 以最快速度重新模拟一个录像并校验结局,
+// --seek 再跳到第 T 个 tick (从最近的检查点出发) 打印那一刻的状态
+//
+// --players 大于 1 时在同一个棋盘上跑 P 条贪心的蛇 (MultiSimulation), 报告胜负和平局
+//
+// --expect-survival 1 时只要有一局死掉就以 3 退出 (自动驾驶的回归测试: 有哈密顿回路的棋盘上
+// auto 和 cycle 都不应该死; 跑到 max-ticks 还没结束的局不算)
+//
+// --profile 在结束时导出分段计时 (需要用 SNAKE_ENABLE_PROFILER 编译)
+// ------------------------------------------------------------------------------------
+#include "Autopilot.h"
+#include "BatchEnv.h"
+#include "MultiSimulation.h"
+#include "Profiler.h"
+#include "Replay.h"
+#include "Simulation.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// ------------------------------------------------------------------------------------
+// Input Sources
+// ------------------------------------------------------------------------------------
+typedef enum
+{
+    POLICY_GREEDY = 0, // 朝食物走, 避开必死的格子
+    POLICY_RANDOM,     // 随机选择不会立即死亡的方向
+    POLICY_AUTOPILOT,  // Autopilot: BFS 最短路径 + 安全检查
+    POLICY_CYCLE,      // Autopilot: 沿哈密顿回路
+    POLICY_SCRIPT      // 按脚本输入
+} InputPolicy;
+
+template <class Sim>
+static SnakeDirection GreedyInput(const Sim &sim)
+{
+    const Cell head = sim.GetSnake().Head().position;
+    const Food &food = sim.GetFood();
+
+    SnakeDirection best = sim.Direction();
+    int bestDistance = -1;
+    for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+    {
+        SnakeDirection dir = (SnakeDirection)d;
+        if (IsOpposite(dir, sim.Direction()))
+            continue;
+
+        Cell next = MoveCell(head, dir);
+        if (sim.IsDeadly(next))
+            continue;
+
+        int distance = std::abs(next.x - food.position.x) + std::abs(next.y - food.position.y);
+        if (bestDistance < 0 || distance < bestDistance)
+        {
+            best = dir;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+// 多人对战里的贪心: 和 GreedyInput 一样, 只是查的是共享的 owner 网格
+template <class Board>
+static SnakeDirection VersusGreedyInput(const BasicMultiSimulation<Board> &sim, int player)
+{
+    const Cell head = sim.GetSnake(player).Head().position;
+    const Food &food = sim.GetFood();
+    const SnakeDirection current = sim.Direction(player);
+
+    SnakeDirection best = current;
+    int bestDistance = -1;
+    for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+    {
+        SnakeDirection dir = (SnakeDirection)d;
+        if (IsOpposite(dir, current))
+            continue;
+
+        Cell next = MoveCell(head, dir);
+        if (sim.IsDeadly(next))
+            continue;
+
+        int distance = std::abs(next.x - food.position.x) + std::abs(next.y - food.position.y);
+        if (bestDistance < 0 || distance < bestDistance)
+        {
+            best = dir;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+template <class Sim>
+static SnakeDirection RandomInput(const Sim &sim, Pcg32 &rng)
+{
+    const Cell head = sim.GetSnake().Head().position;
+
+    SnakeDirection safe[4];
+    int safeCount = 0;
+    for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+    {
+        SnakeDirection dir = (SnakeDirection)d;
+        if (!IsOpposite(dir, sim.Direction()) && !sim.IsDeadly(MoveCell(head, dir)))
+            safe[safeCount++] = dir;
+    }
+    if (safeCount == 0)
+        return sim.Direction();
+    return safe[rng.Bounded((uint32_t)safeCount)];
+}
+
+template <class Sim>
+static SnakeDirection ScriptInput(const Sim &sim, const std::string &script, size_t tick)
+{
+    switch (script[tick % script.size()])
+    {
+    case 'R':
+        return DIR_RIGHT;
+    case 'L':
+        return DIR_LEFT;
+    case 'U':
+        return DIR_UP;
+    case 'D':
+        return DIR_DOWN;
+    default:
+        return sim.Direction();
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Runner
+// ------------------------------------------------------------------------------------
+struct RunConfig
+{
+    int games;
+    uint32_t seed;
+    uint64_t maxTicks; // 每局最多跑多少 tick, 防止脚本绕圈永远不死
+    InputPolicy policy;
+    std::string script;
+    int batch;   // > 0 时走 BatchEnv
+    int threads; // BatchEnv 的线程数, 0 = 全部硬件线程
+    std::string recordFile; // 非空时把第一局保存成录像
+    int players;            // > 1 时走 MultiSimulation
+};
+
+struct RunStats
+{
+    uint64_t totalTicks;
+    long long totalScore;
+    int bestScore;
+    int wins;
+    int draws;  // 多人对战: 没有赢家的局数
+    int deaths; // 单人: 撞死结束的局数 (不含跑到 max-ticks 的局)
+    int finishedGames;
+};
+
+template <class Board>
+static RunStats RunGames(const Board &board, const RunConfig &config)
+{
+    BasicSimulation<Board> sim;
+    BasicAutopilot<Board> autopilot;
+    autopilot.Reset(board, config.policy == POLICY_CYCLE ? AUTOPILOT_CYCLE : AUTOPILOT_BFS);
+    Pcg32 inputRng(config.seed, 0x9e3779b9u); // 和各局的食物流分开
+    RunStats stats = {};
+
+    ReplayRecorder recorder;
+    for (int game = 0; game < config.games; game++)
+    {
+        sim.Reset(board, config.seed, (uint64_t)game); // 每局一个独立的流
+        const bool recording = (game == 0 && !config.recordFile.empty());
+        if (recording)
+            recorder.Begin(sim.Width(), sim.Height(), config.seed, (uint64_t)game, sim.Direction());
+
+        while (sim.Running() && sim.Ticks() < config.maxTicks)
+        {
+            SnakeDirection input;
+            switch (config.policy)
+            {
+            case POLICY_RANDOM:
+                input = RandomInput(sim, inputRng);
+                break;
+            case POLICY_AUTOPILOT:
+            case POLICY_CYCLE:
+                input = autopilot.Decide(sim);
+                break;
+            case POLICY_SCRIPT:
+                input = ScriptInput(sim, config.script, (size_t)sim.Ticks());
+                break;
+            default:
+                input = GreedyInput(sim);
+                break;
+            }
+            {
+                SNAKE_PROFILE_SCOPE(PROFILE_STEP);
+                sim.Step(input);
+            }
+            if (recording)
+                recorder.RecordTick(sim.Ticks(), sim.Direction());
+        }
+
+        if (recording)
+        {
+            recorder.Finish(sim.Ticks(), sim.Score(), sim.Status());
+            if (!SaveReplay(config.recordFile.c_str(), recorder.GetReplay()))
+                fprintf(stderr, "cannot write replay %s\n", config.recordFile.c_str());
+        }
+
+        stats.totalTicks += sim.Ticks();
+        stats.totalScore += sim.Score();
+        if (sim.Score() > stats.bestScore)
+            stats.bestScore = sim.Score();
+        if (sim.Status() == SIM_WON)
+            stats.wins++;
+        else if (sim.Status() == SIM_DEAD)
+            stats.deaths++;
+    }
+    stats.finishedGames = config.games;
+    return stats;
+}
+
+template <class Board>
+static RunStats RunBatch(const Board &board, const RunConfig &config)
+{
+    BasicBatchEnv<Board> env(config.batch, board, config.seed, config.threads);
+    std::vector<SnakeDirection> actions(config.batch);
+    std::vector<EnvStepInfo> infos(config.batch);
+    RunStats stats = {};
+
+    int finished = 0;
+    uint64_t steps = 0;
+    while (finished < config.games && steps < config.maxTicks)
+    {
+        // 策略本身也按块并行, 用的是同一个线程池
+        env.Pool().ParallelFor(env.Size(), 64, [&](int begin, int end) {
+            for (int i = begin; i < end; i++)
+                actions[i] = GreedyInput(env.Game(i));
+        });
+        env.Step(actions.data(), infos.data());
+        steps++;
+
+        for (int i = 0; i < env.Size(); i++)
+        {
+            const EnvStepInfo &info = infos[i];
+            if (!info.done)
+                continue;
+
+            finished++;
+            stats.totalScore += info.episodeScore;
+            if (info.episodeScore > stats.bestScore)
+                stats.bestScore = info.episodeScore;
+            if (info.won)
+                stats.wins++;
+            else
+                stats.deaths++;
+        }
+    }
+    stats.totalTicks = steps * (uint64_t)env.Size();
+    stats.finishedGames = finished;
+    return stats;
+}
+
+template <class Board>
+static RunStats RunVersus(const Board &board, const RunConfig &config)
+{
+    BasicMultiSimulation<Board> sim;
+    RunStats stats = {};
+
+    SnakeDirection inputs[MAX_PLAYERS];
+    for (int game = 0; game < config.games; game++)
+    {
+        sim.Reset(board, config.players, config.seed, (uint64_t)game);
+        while (sim.Running() && sim.Ticks() < config.maxTicks)
+        {
+            for (int p = 0; p < sim.PlayerCount(); p++)
+                inputs[p] = sim.Alive(p) ? VersusGreedyInput(sim, p) : sim.Direction(p);
+            {
+                SNAKE_PROFILE_SCOPE(PROFILE_STEP);
+                sim.Step(inputs);
+            }
+        }
+
+        stats.totalTicks += sim.Ticks();
+        for (int p = 0; p < sim.PlayerCount(); p++)
+        {
+            stats.totalScore += sim.Score(p);
+            if (sim.Score(p) > stats.bestScore)
+                stats.bestScore = sim.Score(p);
+        }
+        if (sim.Winner() >= 0)
+            stats.wins++;
+        else
+            stats.draws++;
+    }
+    stats.finishedGames = config.games;
+    return stats;
+}
+
+template <class Board>
+static RunStats Run(const Board &board, const RunConfig &config)
+{
+    if (config.players > 1)
+        return RunVersus(board, config);
+    return (config.batch > 0) ? RunBatch(board, config) : RunGames(board, config);
+}
+
+// 常用大小走编译期棋盘 (std::array 存储, 常量下标), 其它大小走运行时后备实现
+static RunStats RunPreset(int width, int height, const RunConfig &config)
+{
+    if (width == GAME_AREA_WIDTH && height == GAME_AREA_HEIGHT)
+        return Run(ClassicBoard(), config);
+    if (width == 32 && height == 32)
+        return Run(FixedBoard<32, 32>(), config);
+    if (width == 64 && height == 64)
+        return Run(FixedBoard<64, 64>(), config);
+    return Run(DynamicBoard(width, height), config);
+}
+
+// ------------------------------------------------------------------------------------
+// Replay Playback
+// ------------------------------------------------------------------------------------
+template <class Board>
+static int PlayReplay(const Replay &replay, const Board &board, bool seek, uint64_t seekTick)
+{
+    BasicReplayPlayer<Board> player;
+    if (!player.Open(replay, board))
+    {
+        fprintf(stderr, "replay board does not match\n");
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    while (!player.AtEnd())
+    {
+        player.Step();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const BasicSimulation<Board> &sim = player.GetSimulation();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    printf("replay:      %dx%d seed %llu stream %llu, %u turns in %zu bytes\n", replay.width, replay.height,
+           (unsigned long long)replay.seed, (unsigned long long)replay.stream, replay.eventCount, replay.events.size());
+    printf("ticks:       %llu (recorded %llu)\n", (unsigned long long)sim.Ticks(),
+           (unsigned long long)replay.tickCount);
+    printf("score:       %d (recorded %d)\n", sim.Score(), replay.score);
+    printf("verified:    %s\n", player.Matches() ? "yes" : "NO");
+    printf("ticks/s:     %.0f\n", seconds > 0.0 ? sim.Ticks() / seconds : 0.0);
+
+    if (seek)
+    {
+        start = std::chrono::steady_clock::now();
+        player.Seek(seekTick);
+        end = std::chrono::steady_clock::now();
+
+        const Cell head = sim.GetSnake().Head().position;
+        printf("seek:        tick %llu in %.1f us: head (%d, %d), length %zu, score %d\n",
+               (unsigned long long)sim.Ticks(), std::chrono::duration<double, std::micro>(end - start).count(),
+               head.x, head.y, sim.GetSnake().Size(), sim.Score());
+        printf("checkpoints: %zu every %llu ticks\n", player.CheckpointCount(),
+               (unsigned long long)player.CheckpointInterval());
+    }
+    return player.Matches() ? 0 : 2;
+}
+
+static int PlayReplayFile(const char *fileName, bool seek, uint64_t seekTick)
+{
+    Replay replay;
+    if (!LoadReplay(fileName, replay))
+    {
+        fprintf(stderr, "cannot read replay %s\n", fileName);
+        return 1;
+    }
+    if (replay.width == GAME_AREA_WIDTH && replay.height == GAME_AREA_HEIGHT)
+        return PlayReplay(replay, ClassicBoard(), seek, seekTick);
+    return PlayReplay(replay, DynamicBoard(replay.width, replay.height), seek, seekTick);
+}
+
+// ------------------------------------------------------------------------------------
+// Program main entry point
+// ------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    int games = 1000;
+    int width = 40;
+    int height = 30;
+    uint32_t seed = 1;
+    uint64_t maxTicks = 100000;
+    InputPolicy policy = POLICY_GREEDY;
+    std::string script;
+    int batch = 0;
+    int threads = 0;
+    std::string recordFile;
+    int players = 1;
+    const char *replayFile = nullptr;
+    bool seek = false;
+    uint64_t seekTick = 0;
+    const char *profileFile = nullptr;
+    bool expectSurvival = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr)
+        {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 1;
+        }
+        i++;
+
+        if (strcmp(arg, "--games") == 0)
+            games = atoi(value);
+        else if (strcmp(arg, "--width") == 0)
+            width = atoi(value);
+        else if (strcmp(arg, "--height") == 0)
+            height = atoi(value);
+        else if (strcmp(arg, "--seed") == 0)
+            seed = (uint32_t)strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--max-ticks") == 0)
+            maxTicks = strtoull(value, nullptr, 10);
+        else if (strcmp(arg, "--policy") == 0)
+        {
+            if (strcmp(value, "random") == 0)
+                policy = POLICY_RANDOM;
+            else if (strcmp(value, "auto") == 0)
+                policy = POLICY_AUTOPILOT;
+            else if (strcmp(value, "cycle") == 0)
+                policy = POLICY_CYCLE;
+            else
+                policy = POLICY_GREEDY;
+        }
+        else if (strcmp(arg, "--batch") == 0)
+            batch = atoi(value);
+        else if (strcmp(arg, "--threads") == 0)
+            threads = atoi(value);
+        else if (strcmp(arg, "--record") == 0)
+            recordFile = value;
+        else if (strcmp(arg, "--players") == 0)
+            players = atoi(value);
+        else if (strcmp(arg, "--profile") == 0)
+            profileFile = value;
+        else if (strcmp(arg, "--expect-survival") == 0)
+            expectSurvival = atoi(value) != 0;
+        else if (strcmp(arg, "--replay") == 0)
+            replayFile = value;
+        else if (strcmp(arg, "--seek") == 0)
+        {
+            seek = true;
+            seekTick = strtoull(value, nullptr, 10);
+        }
+        else if (strcmp(arg, "--script") == 0)
+        {
+            std::ifstream file(value);
+            script.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            if (script.empty())
+            {
+                fprintf(stderr, "cannot read script %s\n", value);
+                return 1;
+            }
+            policy = POLICY_SCRIPT;
+        }
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 1;
+        }
+    }
+
+    if (replayFile != nullptr)
+        return PlayReplayFile(replayFile, seek, seekTick);
+
+    if (players < 1 || players > MAX_PLAYERS || (players > 1 && (width < 8 || height <= players)))
+    {
+        fprintf(stderr, "invalid player count\n");
+        return 1;
+    }
+    if (games <= 0 || batch < 0 || width < 3 || height < 1 || width > MAX_BOARD_SIZE || height > MAX_BOARD_SIZE)
+    {
+        fprintf(stderr, "invalid board or game count\n");
+        return 1;
+    }
+
+    RunConfig config = {games, seed, maxTicks, policy, script, batch, threads, recordFile, players};
+    if ((policy == POLICY_AUTOPILOT || policy == POLICY_CYCLE) && batch == 0 && players == 1 &&
+        !HasHamiltonianCycle(width, height))
+        printf("note:        %dx%d has no Hamiltonian cycle (both sides odd), survival is not guaranteed\n", width,
+               height);
+
+    auto start = std::chrono::steady_clock::now();
+    RunStats stats = RunPreset(width, height, config);
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    printf("games:       %d (%dx%d)\n", stats.finishedGames, width, height);
+    if (batch > 0)
+        printf("batch:       %d x %s threads (%s lanes)\n", batch, threads > 0 ? std::to_string(threads).c_str() : "all",
+               LaneKernelName());
+    printf("ticks:       %llu\n", (unsigned long long)stats.totalTicks);
+    if (players > 1)
+    {
+        printf("players:     %d (decided %d, draws %d)\n", players, stats.wins, stats.draws);
+        printf("avg score:   %.1f per snake (best %d)\n", (double)stats.totalScore / ((double)stats.finishedGames * players), stats.bestScore);
+    }
+    else
+    {
+        printf("avg score:   %.1f (best %d, wins %d)\n", (double)stats.totalScore / (stats.finishedGames > 0 ? stats.finishedGames : 1), stats.bestScore, stats.wins);
+        printf("deaths:      %d (unfinished %d)\n", stats.deaths, stats.finishedGames - stats.wins - stats.deaths);
+    }
+    printf("time:        %.3f s\n", seconds);
+    printf("ticks/s:     %.0f\n", seconds > 0.0 ? stats.totalTicks / seconds : 0.0);
+
+    if (profileFile != nullptr)
+    {
+        size_t length = strlen(profileFile);
+        bool json = length >= 5 && strcmp(profileFile + length - 5, ".json") == 0;
+        if (!(json ? SaveProfileJson(profileFile) : SaveProfileCsv(profileFile)))
+        {
+            fprintf(stderr, "cannot write profile %s (built without SNAKE_ENABLE_PROFILER?)\n", profileFile);
+            return 1;
+        }
+    }
+    if (expectSurvival && players == 1 && stats.deaths > 0)
+    {
+        fprintf(stderr, "expected no deaths, got %d\n", stats.deaths);
+        return 3;
+    }
+    return 0;
+}
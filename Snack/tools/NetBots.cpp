@@ -0,0 +1,316 @@
+// ------------------------------------------------------------------------------------
+// 服务器压测和协议校验 (Linux): 开很多个机器人客户端, 每个一个 UDP socket
+//
+// 用法:
+//   NetBots [--host 127.0.0.1] [--port P] [--bots N] [--tick-ms T] [--duration SECONDS] [--predict 0|1]
+//
+// 每个机器人加入任意有空位的房间, 用 NetReplica 从关键帧和 delta 维护服务器状态的副本,
+// 每个 tick 根据副本发送一个不会立即撞死的方向; 结束时报告应用的 delta 数,
+// 以及副本和服务器不一致 (desync) 或者丢了太多 tick 需要等关键帧 (gap) 的次数
+//
+// --predict 1 时机器人像游戏客户端一样通过 NetSession 预测: 根据预测状态决策, 输入标上生效的 tick,
+// 报告回滚次数, 重算的 tick 数和本地输入晚到的次数 (每个机器人的预测环形缓冲区有几 MB, 机器人别开太多)
+// ------------------------------------------------------------------------------------
+#include "Constants.h"
+#include "NetProtocol.h"
+#include "NetSession.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+struct Bot
+{
+    int fd;
+    bool welcomed;
+    uint32_t room;
+    int player;
+    int playerCount;
+    SnakeDirection direction;
+    ClassicNetReplica replica;
+    std::unique_ptr<NetSession> session; // 只在 --predict 时分配
+};
+
+struct BotStats
+{
+    uint64_t keyframes;
+    uint64_t applied;
+    uint64_t stale;
+    uint64_t gaps;
+    uint64_t desyncs;
+    uint64_t rounds; // 收到结束标记的局数 (按机器人计)
+    uint64_t bytesIn;
+};
+
+static int64_t NowMicros(void)
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// 朝食物走, 避开会立即撞死的格子
+static SnakeDirection Decide(const ClassicMultiSimulation &sim, int player)
+{
+    const SnakeDirection current = sim.Direction(player);
+    const Cell head = sim.GetSnake(player).Head().position;
+    const Food &food = sim.GetFood();
+
+    SnakeDirection best = current;
+    int bestDistance = -1;
+    for (int d = DIR_RIGHT; d <= DIR_DOWN; d++)
+    {
+        SnakeDirection dir = (SnakeDirection)d;
+        Cell next = MoveCell(head, dir);
+        if (IsOpposite(dir, current) || sim.IsDeadly(next))
+            continue;
+
+        int distance = std::abs(next.x - food.position.x) + std::abs(next.y - food.position.y);
+        if (bestDistance < 0 || distance < bestDistance)
+        {
+            best = dir;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+static void HandleDatagram(Bot &bot, const uint8_t *data, size_t size, NetKeyframe &keyframe, BotStats &stats)
+{
+    stats.bytesIn += size;
+    if (bot.session)
+    {
+        bot.session->Receive(data, size);
+        return;
+    }
+
+    switch (MessageType(data, size))
+    {
+    case NET_WELCOME:
+        if (ReadWelcome(data, size, bot.room, bot.player, bot.playerCount))
+            bot.welcomed = true;
+        break;
+    case NET_KEYFRAME:
+        if (ReadKeyframe(data, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, keyframe) && keyframe.room == bot.room &&
+            bot.replica.ApplyKeyframe(ClassicBoard(), keyframe))
+            stats.keyframes++;
+        break;
+    case NET_DELTAS:
+    {
+        uint32_t room;
+        uint16_t round;
+        int playerCount;
+        int count;
+        NetDelta deltas[NET_DELTA_REDUNDANCY];
+        if (!ReadDeltas(data, size, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, room, round, playerCount, deltas, count) ||
+            room != bot.room)
+            break;
+        for (int i = 0; i < count; i++)
+        {
+            switch (bot.replica.ApplyDelta(round, deltas[i]))
+            {
+            case NET_APPLIED:
+                stats.applied++;
+                if (deltas[i].flags & NET_FINISHED)
+                    stats.rounds++;
+                break;
+            case NET_STALE:
+                stats.stale++;
+                break;
+            case NET_GAP:
+                stats.gaps++;
+                break;
+            case NET_DESYNC:
+                stats.desyncs++;
+                break;
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Program main entry point
+// ------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    const char *host = "127.0.0.1";
+    int port = 7777;
+    int botCount = 100;
+    double tickMs = MOVE_INTERVAL_MICROS / 1000.0;
+    double duration = 10.0;
+    bool predict = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr)
+        {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 1;
+        }
+        i++;
+
+        if (strcmp(arg, "--host") == 0)
+            host = value;
+        else if (strcmp(arg, "--port") == 0)
+            port = atoi(value);
+        else if (strcmp(arg, "--bots") == 0)
+            botCount = atoi(value);
+        else if (strcmp(arg, "--tick-ms") == 0)
+            tickMs = atof(value);
+        else if (strcmp(arg, "--duration") == 0)
+            duration = atof(value);
+        else if (strcmp(arg, "--predict") == 0)
+            predict = atoi(value) != 0;
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 1;
+        }
+    }
+
+    sockaddr_in server = {};
+    server.sin_family = AF_INET;
+    server.sin_port = htons((uint16_t)port);
+    if (botCount <= 0 || inet_pton(AF_INET, host, &server.sin_addr) != 1)
+    {
+        fprintf(stderr, "invalid host or bot count\n");
+        return 1;
+    }
+
+    int epollFd = epoll_create1(0);
+    std::vector<Bot> bots((size_t)botCount);
+    for (int i = 0; i < botCount; i++)
+    {
+        Bot &bot = bots[i];
+        bot.fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+        if (bot.fd < 0 || connect(bot.fd, (const sockaddr *)&server, sizeof(server)) != 0)
+        {
+            perror("socket");
+            return 1;
+        }
+        bot.welcomed = false;
+        bot.direction = DIR_RIGHT;
+        if (predict)
+            bot.session.reset(new NetSession());
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u32 = (uint32_t)i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, bot.fd, &event);
+    }
+
+    BotStats stats = {};
+    NetKeyframe keyframe = {};
+    std::vector<epoll_event> events(256);
+    uint8_t buffer[NET_MAX_DATAGRAM];
+    const int64_t tickMicros = (int64_t)(tickMs * 1000.0);
+    const int64_t start = NowMicros();
+    const int64_t end = start + (int64_t)(duration * 1000000.0);
+    int64_t nextTick = start;
+
+    while (NowMicros() < end)
+    {
+        int64_t now = NowMicros();
+        if (now >= nextTick)
+        {
+            // 没进房间的重发 JOIN, 进了的发送当前方向 (兼作心跳)
+            for (Bot &bot : bots)
+            {
+                size_t size;
+                if (bot.session)
+                {
+                    const ClassicMultiSimulation &sim = bot.session->GetSimulation();
+                    if (bot.session->Playing() && sim.Running() && sim.Alive(bot.session->LocalPlayer()))
+                        bot.direction = Decide(sim, bot.session->LocalPlayer());
+                    size = bot.session->Tick(bot.direction, buffer, sizeof(buffer));
+                }
+                else if (!bot.welcomed)
+                {
+                    size = WriteJoin(buffer, sizeof(buffer), NET_ANY_ROOM);
+                }
+                else
+                {
+                    const ClassicMultiSimulation &sim = bot.replica.GetSimulation();
+                    if (bot.replica.Synced() && sim.Running() && sim.Alive(bot.player))
+                        bot.direction = Decide(sim, bot.player);
+                    size = WriteInput(buffer, sizeof(buffer), (uint32_t)sim.Ticks() + 1, bot.direction);
+                }
+                send(bot.fd, buffer, size, 0);
+            }
+            nextTick += tickMicros;
+            continue;
+        }
+
+        int timeoutMs = (int)((nextTick - now + 999) / 1000);
+        int ready = epoll_wait(epollFd, events.data(), (int)events.size(), timeoutMs);
+        for (int i = 0; i < ready; i++)
+        {
+            Bot &bot = bots[events[i].data.u32];
+            for (;;)
+            {
+                ssize_t size = recv(bot.fd, buffer, sizeof(buffer), 0);
+                if (size <= 0)
+                    break;
+                HandleDatagram(bot, buffer, (size_t)size, keyframe, stats);
+            }
+        }
+    }
+
+    int welcomed = 0;
+    uint64_t rollbacks = 0;
+    uint64_t resimulated = 0;
+    uint64_t lateInputs = 0;
+    uint64_t leadSum = 0;
+    for (Bot &bot : bots)
+    {
+        if (bot.session)
+        {
+            bot.welcomed = bot.session->Welcomed();
+            stats.gaps += bot.session->Gaps();
+            stats.desyncs += bot.session->Desyncs();
+            rollbacks += bot.session->GetPredictor().Rollbacks();
+            resimulated += bot.session->GetPredictor().ResimulatedTicks();
+            lateInputs += bot.session->GetPredictor().LocalMispredictions();
+            leadSum += (uint64_t)bot.session->InputLead();
+        }
+        if (bot.welcomed)
+        {
+            welcomed++;
+            send(bot.fd, buffer, WriteLeave(buffer, sizeof(buffer)), 0);
+        }
+        close(bot.fd);
+    }
+    close(epollFd);
+
+    double seconds = (NowMicros() - start) / 1000000.0;
+    printf("bots:        %d (%d seated)\n", botCount, welcomed);
+    if (predict)
+    {
+        printf("prediction:  %llu rollbacks, %llu ticks resimulated, %llu late inputs, average lead %.1f ticks\n",
+               (unsigned long long)rollbacks, (unsigned long long)resimulated, (unsigned long long)lateInputs,
+               (double)leadSum / botCount);
+        printf("deltas:      %llu gaps, %llu desyncs\n", (unsigned long long)stats.gaps,
+               (unsigned long long)stats.desyncs);
+        printf("bandwidth:   %.0f bytes/s per bot\n", seconds > 0.0 ? stats.bytesIn / seconds / botCount : 0.0);
+        return stats.desyncs == 0 ? 0 : 1;
+    }
+
+    printf("deltas:      %llu applied, %llu redundant, %llu gaps, %llu desyncs\n",
+           (unsigned long long)stats.applied, (unsigned long long)stats.stale, (unsigned long long)stats.gaps,
+           (unsigned long long)stats.desyncs);
+    printf("keyframes:   %llu, rounds finished %llu\n", (unsigned long long)stats.keyframes,
+           (unsigned long long)stats.rounds);
+    printf("bandwidth:   %.0f bytes/s per bot\n", seconds > 0.0 ? stats.bytesIn / seconds / botCount : 0.0);
+    return stats.desyncs == 0 ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+// ------------------------------------------------------------------------------------
+// 资源打包工具: 把松散的资源文件打成游戏启动时 mmap 的 snake.pak
+//
+// 用法:
+//   PackAssets <output.pak> <file | name=file>...
+//
+// 包里的名字默认是文件名 (不含目录), 也可以用 name=file 指定; 例如
+//   PackAssets snake.pak resources/eat.wav resources/gameover.wav
+// 打好的包放在游戏可执行文件旁边; 写完后重新打开校验一遍并列出内容
+// ------------------------------------------------------------------------------------
+#include "AssetPack.h"
+#include <cstdio>
+#include <cstring>
+
+// ------------------------------------------------------------------------------------
+// Program main entry point
+// ------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <output.pak> <file | name=file>...\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<AssetSource> sources;
+    for (int i = 2; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *equals = strchr(arg, '=');
+        AssetSource source;
+        if (equals != nullptr)
+        {
+            source.name.assign(arg, (size_t)(equals - arg));
+            source.path = equals + 1;
+        }
+        else
+        {
+            const char *slash = strrchr(arg, '/');
+            const char *backslash = strrchr(arg, '\\');
+            if (backslash != nullptr && (slash == nullptr || backslash > slash))
+                slash = backslash;
+            source.name = (slash != nullptr) ? slash + 1 : arg;
+            source.path = arg;
+        }
+        sources.push_back(source);
+    }
+
+    if (!WriteAssetPack(argv[1], sources))
+        return 1;
+
+    AssetPack pack;
+    if (!pack.Open(argv[1]))
+    {
+        fprintf(stderr, "%s: written pack does not validate\n", argv[1]);
+        return 1;
+    }
+    for (int i = 0; i < pack.Count(); i++)
+    {
+        AssetBlob blob;
+        pack.Find(pack.Name(i), blob);
+        printf("%10zu  %s\n", blob.size, pack.Name(i));
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+// ------------------------------------------------------------------------------------
+// 联网对战的专用服务器 (Linux): 固定 tick 推进所有房间, 通过 UDP 广播 delta 和关键帧
+//
+// 用法:
+//   Server [--port P] [--rooms R] [--players N] [--tick-ms T] [--threads T] [--seed S]
+//          [--duration SECONDS] [--quiet 1]
+//
+// 客户端发 JOIN 加入指定房间或者任意有空位的房间, 房间坐满 N 人后开局;
+// --duration 跑够指定秒数后退出 (用于压测), 默认一直跑到 Ctrl+C
+// ------------------------------------------------------------------------------------
+#include "Constants.h"
+#include "NetServer.h"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+static std::atomic<bool> stopRequested(false);
+
+static void OnSignal(int)
+{
+    stopRequested.store(true);
+}
+
+// ------------------------------------------------------------------------------------
+// Program main entry point
+// ------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    NetServerConfig config = {};
+    config.port = 7777;
+    config.roomCount = 1024;
+    config.playersPerRoom = 2;
+    config.tickMicros = MOVE_INTERVAL_MICROS; // 和窗口版一样快
+    config.threads = 0;
+    config.seed = 1;
+    config.verbose = true;
+    double duration = 0.0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr)
+        {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 1;
+        }
+        i++;
+
+        if (strcmp(arg, "--port") == 0)
+            config.port = (uint16_t)atoi(value);
+        else if (strcmp(arg, "--rooms") == 0)
+            config.roomCount = atoi(value);
+        else if (strcmp(arg, "--players") == 0)
+            config.playersPerRoom = atoi(value);
+        else if (strcmp(arg, "--tick-ms") == 0)
+            config.tickMicros = (uint32_t)(atof(value) * 1000.0);
+        else if (strcmp(arg, "--threads") == 0)
+            config.threads = atoi(value);
+        else if (strcmp(arg, "--seed") == 0)
+            config.seed = (uint32_t)strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--duration") == 0)
+            duration = atof(value);
+        else if (strcmp(arg, "--quiet") == 0)
+            config.verbose = atoi(value) == 0;
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 1;
+        }
+    }
+
+    NetServer server;
+    if (!server.Open(config))
+        return 1;
+    printf("listening on udp port %u: %d rooms x %d players, tick %.1f ms\n", server.Port(), config.roomCount,
+           config.playersPerRoom, config.tickMicros / 1000.0);
+    fflush(stdout);
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    std::thread timer;
+    if (duration > 0.0)
+    {
+        timer = std::thread([duration]() {
+            std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+            stopRequested.store(true);
+        });
+    }
+
+    server.Run(stopRequested);
+    if (timer.joinable())
+        timer.join();
+
+    const NetServerStats &stats = server.Stats();
+    printf("ticks:       %llu (%llu room ticks)\n", (unsigned long long)stats.ticks,
+           (unsigned long long)stats.roomTicks);
+    printf("packets:     %llu in, %llu out (%llu bytes, %llu dropped, %llu bad)\n",
+           (unsigned long long)stats.packetsIn, (unsigned long long)stats.packetsOut,
+           (unsigned long long)stats.bytesOut, (unsigned long long)stats.sendDropped,
+           (unsigned long long)stats.badPackets);
+    return 0;
+}